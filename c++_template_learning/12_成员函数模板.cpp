@@ -1,6 +1,79 @@
 #include <iostream>
 #include <deque>
 #include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STACK_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// ֮תģ static_castõ SSE2 ػһָתԪ
+template<typename From, typename To>
+struct ConvertKernel
+{
+	static void run(const From *src, std::size_t n, To *dst)
+	{
+		for (std::size_t i = 0; i < n; i++) {
+			dst[i] = static_cast<To>(src[i]);
+		}
+	}
+};
+
+#ifdef STACK_USE_SSE2
+template<>
+struct ConvertKernel<int, float>
+{
+	static void run(const int *src, std::size_t n, float *dst)
+	{
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			_mm_storeu_ps(dst + i, _mm_cvtepi32_ps(v));
+		}
+		for (; i < n; i++) {
+			dst[i] = static_cast<float>(src[i]);
+		}
+	}
+};
+
+template<>
+struct ConvertKernel<float, double>
+{
+	static void run(const float *src, std::size_t n, double *dst)
+	{
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			__m128 v = _mm_loadu_ps(src + i);
+			_mm_storeu_pd(dst + i, _mm_cvtps_pd(v));
+			_mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+		}
+		for (; i < n; i++) {
+			dst[i] = static_cast<double>(src[i]);
+		}
+	}
+};
+
+template<>
+struct ConvertKernel<int, double>
+{
+	static void run(const int *src, std::size_t n, double *dst)
+	{
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			_mm_storeu_pd(dst + i, _mm_cvtepi32_pd(v));
+			_mm_storeu_pd(dst + i + 2, _mm_cvtepi32_pd(_mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2))));
+		}
+		for (; i < n; i++) {
+			dst[i] = static_cast<double>(src[i]);
+		}
+	}
+};
+#endif
 
 // ĳԱҲģ壬ǶͳԱ -- ջΪ
 // ڵ⣺ֻͨе stack ͬʱſ໥ֵstack ͬ˵ǵԪҲͬ
@@ -21,6 +94,18 @@ public:
 		s.push_back(elem);
 	}
 
+	void push(T &&elem)
+	{
+		s.push_back(std::move(elem));
+	}
+
+	// emplace ҲһԱģ
+	template<typename... Args>
+	void emplace(Args&&... args)
+	{
+		s.emplace_back(std::forward<Args>(args)...);
+	}
+
 	void pop()
 	{
 		assert(!s.empty());
@@ -28,6 +113,15 @@ public:
 		s.pop_back();
 	}
 
+	T pop_value() noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		assert(!s.empty());
+
+		T elem(std::move(s.back()));
+		s.pop_back();
+		return elem;
+	}
+
 	const T& top()
 	{
 		assert(!s.empty());
@@ -48,20 +142,74 @@ public:
 	}
 
 	// ʹóԱģ庯ؿֵ
+	// ע⣺Stack<T>  Stack<T2> ȫͬͣoperator= ܷ rhs ˽гԱ
+	// едֻȿһ tmpͨ top()/pop() ȡ push_frontջ顣
+	//  Stack ʵΪԪ֮󣬾ͿֱӴ rhs.s һԵذ˳ת
 	template<typename T2>
 	const Stack& operator=(const Stack<T2> &rhs)
 	{
-		Stack<T2> tmp(rhs); // create a copy of the assigned stack 
-		s.clear(); // remove existing elements 
-		
-		while (!tmp.empty()) { // copy all elements 
-			s.push_front(tmp.top()); 
-			tmp.pop(); 
-		}
-		
+		assign(rhs.s.begin(), rhs.s.end());
+
 		return *this;
 	}
 
+	//  [first, last) еԪ滻ջԭеԪأfirst Ӧջ
+	template<typename InputIt>
+	void assign(InputIt first, InputIt last)
+	{
+		s.clear();
+		append(first, last);
+	}
+
+	//  [first, last) еԪѹջ
+	template<typename InputIt>
+	void append(InputIt first, InputIt last)
+	{
+		s.insert(s.end(), first, last); // Ԫתֻһ
+	}
+
+	// ָ䣨飩еʹתں
+	template<typename T2>
+	void append(const T2 *first, const T2 *last)
+	{
+		appendRange(first, last, std::integral_constant<bool,
+			std::is_arithmetic<T>::value && std::is_arithmetic<T2>::value>());
+	}
+
+	template<typename T2>
+	void append(T2 *first, T2 *last)
+	{
+		append(static_cast<const T2*>(first), static_cast<const T2*>(last));
+	}
+
+private:
+	template<typename T2>
+	void appendRange(const T2 *first, const T2 *last, std::false_type)
+	{
+		s.insert(s.end(), first, last);
+	}
+
+	// һСĻתʼ L1 У룬Դֻһ
+	template<typename T2>
+	void appendRange(const T2 *first, const T2 *last, std::true_type)
+	{
+		const std::size_t kChunk = 256;
+		T buf[kChunk];
+
+		while (first != last) {
+			std::size_t n = static_cast<std::size_t>(last - first);
+			if (n > kChunk) {
+				n = kChunk;
+			}
+
+			ConvertKernel<T2, T>::run(first, n, buf);
+			s.insert(s.end(), buf, buf + n);
+			first += n;
+		}
+	}
+
+	template<typename> friend class Stack; //  Stack<X> ˴˻ΪԪ
+
 private:
 	std::deque<T> s;
 };
@@ -81,5 +229,12 @@ int main()
 
 	floatStack.printStack();
 
+	// ڵ assign/append
+	int values[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+	Stack<double> doubleStack;
+	doubleStack.assign(std::begin(values), std::end(values)); // ָ䣬ʹ ConvertKernel<int, double>
+	doubleStack.append(values, values + 3);
+	doubleStack.printStack();
+
 	return 0;
 }
\ No newline at end of file
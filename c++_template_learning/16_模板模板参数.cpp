@@ -2,6 +2,95 @@
 #include <vector>
 #include <deque>
 #include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STACK_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// ֮תģ static_castõ SSE2 ػһָתԪ
+template<typename From, typename To>
+struct ConvertKernel
+{
+	static void run(const From *src, std::size_t n, To *dst)
+	{
+		for (std::size_t i = 0; i < n; i++) {
+			dst[i] = static_cast<To>(src[i]);
+		}
+	}
+};
+
+#ifdef STACK_USE_SSE2
+template<>
+struct ConvertKernel<int, float>
+{
+	static void run(const int *src, std::size_t n, float *dst)
+	{
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			_mm_storeu_ps(dst + i, _mm_cvtepi32_ps(v));
+		}
+		for (; i < n; i++) {
+			dst[i] = static_cast<float>(src[i]);
+		}
+	}
+};
+
+template<>
+struct ConvertKernel<float, double>
+{
+	static void run(const float *src, std::size_t n, double *dst)
+	{
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			__m128 v = _mm_loadu_ps(src + i);
+			_mm_storeu_pd(dst + i, _mm_cvtps_pd(v));
+			_mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+		}
+		for (; i < n; i++) {
+			dst[i] = static_cast<double>(src[i]);
+		}
+	}
+};
+
+template<>
+struct ConvertKernel<int, double>
+{
+	static void run(const int *src, std::size_t n, double *dst)
+	{
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			_mm_storeu_pd(dst + i, _mm_cvtepi32_pd(v));
+			_mm_storeu_pd(dst + i + 2, _mm_cvtepi32_pd(_mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2))));
+		}
+		for (; i < n; i++) {
+			dst[i] = static_cast<double>(src[i]);
+		}
+	}
+};
+#endif
+
+//  reserve() ʱ std::vectorǰһԷÿռ䣬 std::dequeʲôҲ
+// ռ䲻ʱ reserveΪԭÿζպҪĴС reserve
+// ׷ԪʱÿһζҪ·䣬ƻ vector μľ̯ O(1)
+template<typename C>
+auto reserveIfPossible(C &c, std::size_t n, int) -> decltype(c.reserve(n), c.capacity(), void())
+{
+	if (n > c.capacity()) {
+		c.reserve(n > 2 * c.capacity() ? n : 2 * c.capacity());
+	}
+}
+
+template<typename C>
+void reserveIfPossible(C &, std::size_t, long)
+{
+}
 
 // ģҲһģ
 
@@ -15,11 +104,14 @@
 // Ϊ˾Ҫ Stack ĶнڶģΪģģ塣
 // template<typename T, typename Container = std::vector<T>> 滻Ϊ
 template<typename T, 
-template<typename Elem, typename Alloc = std::allocator<Elem>> class Container = std::vector>
+template<typename Elem, typename Alloc = std::allocator<Elem>> class Container = std::vector,
+typename Allocator = std::allocator<T>>
 //  Alloc ʡԲд
+//  Allocator ᱻ Container  Alloc ĬȻ std::allocator
+// ҲԻԶķڴءarena з䣬 ģӦ4--ģģArena.cpp
 class Stack
 {
-	using Iterator = typename Container<T>::iterator;
+	using Iterator = typename Container<T, Allocator>::iterator;
 
 public:
 	Stack()
@@ -27,11 +119,28 @@ public:
 		std::cout << "-------------- Template Stack ------------" << std::endl;
 	}
 
+	// ״̬ķָĳ arenaҪڹʱ
+	explicit Stack(const Allocator &alloc) : s(alloc)
+	{
+		std::cout << "-------------- Template Stack ------------" << std::endl;
+	}
+
 	void push(const T &elem)
 	{
 		s.push_back(elem);
 	}
 
+	void push(T &&elem)
+	{
+		s.push_back(std::move(elem));
+	}
+
+	template<typename... Args>
+	void emplace(Args&&... args)
+	{
+		s.emplace_back(std::forward<Args>(args)...);
+	}
+
 	void pop()
 	{
 		assert(!s.empty());
@@ -39,6 +148,15 @@ public:
 		s.pop_back();
 	}
 
+	T pop_value() noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		assert(!s.empty());
+
+		T elem(std::move(s.back()));
+		s.pop_back();
+		return elem;
+	}
+
 	const T& top()
 	{
 		assert(!s.empty());
@@ -60,23 +178,93 @@ public:
 
 	// ʹģؿֵ ͬҪд
 	template<typename T2, template<typename Elem2, 
-			 typename Alloc2 = std::allocator<Elem2>> class Container2 >
+			 typename Alloc2 = std::allocator<Elem2>> class Container2, typename Allocator2 >
 		//  Alloc2 ֿʡ
-	const Stack& operator=(const Stack<T2, Container2> &rhs)
+	const Stack& operator=(const Stack<T2, Container2, Allocator2> &rhs)
 	{
-		Stack<T2, Container2> tmp(rhs); // create a copy of the assigned stack 
-		s.clear(); // remove existing elements 
-
-		while (!tmp.empty()) { // copy all elements 
-			s.push_front(tmp.top());
-			tmp.pop();
-		}
+		// ԭдȿһ tmp top()/pop()/push_front()飬
+		// ҵ Container  std::vector ʱû push_front޷롣
+		//  Stack ʵΪԪֱһԵת rhs.s
+		s.clear();
+		appendFrom(rhs.s);
 
 		return *this;
 	}
 
+	//  [first, last) еԪ滻ջԭеԪأfirst Ӧջ
+	template<typename InputIt>
+	void assign(InputIt first, InputIt last)
+	{
+		s.clear();
+		append(first, last);
+	}
+
+	//  [first, last) еԪѹջУǰinsert Ԫظֻһڴ
+	template<typename InputIt>
+	void append(InputIt first, InputIt last)
+	{
+		s.insert(s.end(), first, last);
+	}
+
+	// ָ䣨顢std::vector ݣеʹתں
+	template<typename T2>
+	void append(const T2 *first, const T2 *last)
+	{
+		reserveIfPossible(s, s.size() + static_cast<std::size_t>(last - first), 0);
+		appendRange(first, last, std::integral_constant<bool,
+			std::is_arithmetic<T>::value && std::is_arithmetic<T2>::value>());
+	}
+
+	template<typename T2>
+	void append(T2 *first, T2 *last)
+	{
+		append(static_cast<const T2*>(first), static_cast<const T2*>(last));
+	}
+
+private:
+	// Ԫŵ std::vector ֱӰָתת
+	template<typename T2, typename Alloc2>
+	void appendFrom(const std::vector<T2, Alloc2> &c)
+	{
+		append(c.data(), c.data() + c.size());
+	}
+
+	template<typename C>
+	void appendFrom(const C &c)
+	{
+		append(c.begin(), c.end());
+	}
+
+	template<typename T2>
+	void appendRange(const T2 *first, const T2 *last, std::false_type)
+	{
+		s.insert(s.end(), first, last);
+	}
+
+	// һСĻתʼ L1 У룬Դֻһ
+	template<typename T2>
+	void appendRange(const T2 *first, const T2 *last, std::true_type)
+	{
+		const std::size_t kChunk = 256;
+		T buf[kChunk];
+
+		while (first != last) {
+			std::size_t n = static_cast<std::size_t>(last - first);
+			if (n > kChunk) {
+				n = kChunk;
+			}
+
+			ConvertKernel<T2, T>::run(first, n, buf);
+			s.insert(s.end(), buf, buf + n);
+			first += n;
+		}
+	}
+
+	template<typename, template<typename, typename> class, typename>
+	friend class Stack; //  Stack ʵ˴˻ΪԪ
+
 private:
-	Container<T> s;
+	Container<T, Allocator> s;
 };
 
 
@@ -92,5 +280,17 @@ int main()
 	s2 = s1;
 	s2.printStack();
 
+	//  std::vector Ϊʱint -> floatfloat -> double ת
+	Stack<int> s3; // Ĭ std::vector
+	int values[] = { 1, 2, 3, 4, 5, 6 };
+	s3.assign(std::begin(values), std::end(values));
+
+	Stack<float> s4;
+	s4 = s3;
+	Stack<double> s5;
+	s5 = s4;
+	s5.append(values, values + 2);
+	s5.printStack();
+
 	return 0;
 }
\ No newline at end of file
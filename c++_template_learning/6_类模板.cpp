@@ -1,9 +1,57 @@
 #include <iostream>
 #include <vector>
 #include <cassert>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <type_traits>
 
 /* ģ̽-- stack Ϊ */
 
+// C++14 лû std::spanһ򵥵ͼ棺ָֻͳȣӵԪ
+template<typename T>
+class Span
+{
+public:
+	Span(T *data_, std::size_t size_) : ptr(data_), len(size_)
+	{
+
+	}
+
+	T* data() const
+	{
+		return ptr;
+	}
+
+	std::size_t size() const
+	{
+		return len;
+	}
+
+	T* begin() const
+	{
+		return ptr;
+	}
+
+	T* end() const
+	{
+		return ptr + len;
+	}
+
+	T& operator[](std::size_t i) const
+	{
+		return ptr[i];
+	}
+
+private:
+	T *ptr;
+	std::size_t len;
+};
+
 //  Stack<T>  T ģ
 template<typename T>
 class Stack
@@ -20,6 +68,27 @@ public:
 		s.push_back( elem );
 	}
 
+	// ֵ汾ʱʱֱӡ͵ߡԴһ
+	void push(T &&elem)
+	{
+		s.push_back(std::move(elem));
+	}
+
+	// תֱڲԪأһƶʡ
+	template<typename... Args>
+	void emplace(Args&&... args)
+	{
+		s.emplace_back(std::forward<Args>(args)...);
+	}
+
+	// ѹ [first, last)ǰvector::insert ԪظֻһΣ
+	//  T ƽָʱ׼ֱ memmove ڴ
+	template<typename InputIt>
+	void push_range(InputIt first, InputIt last)
+	{
+		s.insert(s.end(), first, last);
+	}
+
 	void pop()
 	{
 		assert( !s.empty() );
@@ -27,6 +96,26 @@ public:
 		s.pop_back();
 	}
 
+	// һε n Ԫأһ erase ƽֻǸһ size
+	void pop_n(std::size_t n)
+	{
+		assert(n <= s.size());
+
+		s.erase(s.end() - static_cast<std::ptrdiff_t>(n), s.end());
+	}
+
+	// ջԪƶ
+	// ׼ std::stack  top()  pop() ֿΪءʱ׳쳣ԪؾͶʧˣ
+	// ƶ첻쳣ͣһⲢڣ noexcept һд˳
+	T pop_value() noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		assert(!s.empty());
+
+		T elem(std::move(s.back()));
+		s.pop_back();
+		return elem;
+	}
+
 	const T& top()
 	{
 		assert(!s.empty());
@@ -34,11 +123,24 @@ public:
 		return s.back();
 	}
 
+	// ջ n Ԫأϵ˳򣩣
+	Span<const T> top_n(std::size_t n) const
+	{
+		assert(n <= s.size());
+
+		return Span<const T>(s.data() + (s.size() - n), n);
+	}
+
 	bool empty() const
 	{
 		return s.empty();
 	}
 
+	std::size_t size() const
+	{
+		return s.size();
+	}
+
 	void printStack() const
 	{
 		for (auto it : s) {
@@ -51,6 +153,45 @@ private:
 	std::vector<T> s;
 };
 
+// C++14 лû std::string_viewһ򵥵ַֻͼ棺ָֻͳȣӵҲַ
+class StringView
+{
+public:
+	StringView(const char *data_, std::size_t size_) : ptr(data_), len(size_)
+	{
+
+	}
+
+	const char* data() const
+	{
+		return ptr;
+	}
+
+	std::size_t size() const
+	{
+		return len;
+	}
+
+	std::string str() const
+	{
+		return std::string(ptr, len);
+	}
+
+	bool operator==(const StringView &rhs) const
+	{
+		return len == rhs.len && std::equal(ptr, ptr + len, rhs.ptr);
+	}
+
+	friend std::ostream& operator<<(std::ostream &os, const StringView &v)
+	{
+		return os.write(v.ptr, static_cast<std::streamsize>(v.len));
+	}
+
+private:
+	const char *ptr;
+	std::size_t len;
+};
+
 // ζģػ:Զģĳһģػ
 // ģ"ػ"ǶĳһضŻȥģĳһضʵ֮Ϊ;
 template<> // Ϊػһģ壬ģǰҪһ template<>Ҫָϣػ
@@ -62,43 +203,274 @@ public:
 		std::cout << "-------------- Template Stack Full Specialization ------------" << std::endl;
 	}
 
+	// ػ汾Բģȫͬڲʵ֣
+	// std::vector<std::string> ÿ SSO ȵַҪڶϷһΣ
+	// ַβӵشһ chars У offsets ¼ÿַʼλã
+	//  i ַ [offsets[i], offsets[i + 1])һ chars.size() Ϊֹ
+	// str ָ chars  s.push(s.top()) chars·䣩ٰԭƫ strſ
+	// offsets ׷ӣ׳쳣ʱ chars ԭĳȣ֤ջᴦһ޸ĵ״̬
+	void push(const char *str, std::size_t len)
+	{
+		const char *base = chars.data();
+		const bool alias = len > 0 && std::less_equal<const char*>()(base, str) && std::less<const char*>()(str, base + chars.size());
+		const std::size_t pos = alias ? static_cast<std::size_t>(str - base) : 0;
+
+		const std::size_t old = chars.size();
+		chars.resize(old + len);
+		if (alias) {
+			str = chars.data() + pos;
+		}
+		std::copy(str, str + len, chars.data() + old);
+		try {
+			offsets.push_back(old);
+		}
+		catch (...) {
+			chars.resize(old);
+			throw;
+		}
+	}
+
+	void push(StringView elem)
+	{
+		push(elem.data(), elem.size());
+	}
+
 	void push(const std::string &elem)
 	{
-		s.push_back(elem);
+		push(elem.data(), elem.size());
+	}
+
+	void push(const char *str)
+	{
+		push(str, std::char_traits<char>::length(str));
+	}
+
+	// ַҪ chars Уֵֵû
+	void push(std::string &&elem)
+	{
+		push(elem.data(), elem.size());
+	}
+
+	//  std::string Ĺһʱַٷ chars 
+	template<typename... Args>
+	void emplace(Args&&... args)
+	{
+		push(std::string(std::forward<Args>(args)...));
 	}
 
+	// ʱֻҪ chars ض̵ջַʼλ
 	void pop()
 	{
-		assert(!s.empty());
+		assert(!offsets.empty());
 
-		s.pop_back();
+		chars.resize(offsets.back());
+		offsets.pop_back();
 	}
 
-	const std::string& top()
+	// ջеַκһ std::stringȡֻܿһ
+	std::string pop_value()
 	{
-		assert(!s.empty());
+		std::string elem = top().str();
+		pop();
+		return elem;
+	}
 
-		return s.back();
+	// صͼһ push/pop ֮ǰЧ
+	StringView top() const
+	{
+		assert(!offsets.empty());
+
+		return StringView(chars.data() + offsets.back(), chars.size() - offsets.back());
 	}
 
 	bool empty() const
 	{
-		return s.empty();
+		return offsets.empty();
+	}
+
+	std::size_t size() const
+	{
+		return offsets.size();
+	}
+
+	// ǰΪ count ַһ bytes ַԤռ
+	void reserve(std::size_t count, std::size_t bytes)
+	{
+		offsets.reserve(count);
+		chars.reserve(bytes);
 	}
 
 	void printStack() const
 	{
-		for (auto it : s) {
-			std::cout << it.c_str() << std::endl;
+		// ֱӰ chars еַдκʱ std::string
+		for (std::size_t i = 0; i < offsets.size(); i++) {
+			std::size_t end = (i + 1 < offsets.size()) ? offsets[i + 1] : chars.size();
+			std::cout.write(chars.data() + offsets[i], static_cast<std::streamsize>(end - offsets[i]));
+			std::cout << std::endl;
 		}
 	}
 
 private:
 	// ڱػģ壬гԱĶ嶼Ӧñɡ桱ԱҲ˵  T ĵطӦñ滻ػģ
-	std::vector<std::string> s; 
+	std::vector<char> chars;          // ַַβ
+	std::vector<std::size_t> offsets; // ÿַ chars еʼλ
 };
 
 
+// һȫػӣStack<bool>
+// ģ std::vector<bool> 洢׼˰λ洢ػֻλ
+// ֱӰԪذλ 64 λУ i Ԫ words[i / 64] ĵ i % 64 λ
+// Ϳһѹ/ 64 Ԫأͳ true ĸҲֻҪÿһ popcount
+// Լ nbits ЩλʼΪ 0
+inline unsigned popcount64(std::uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<unsigned>(__builtin_popcountll(x));
+#else
+	x = x - ((x >> 1) & 0x5555555555555555ull);
+	x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+	x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+	return static_cast<unsigned>((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+template<>
+class Stack<bool>
+{
+public:
+	Stack()
+	{
+		std::cout << "-------------- Template Stack Full Specialization (bool) ------------" << std::endl;
+	}
+
+	void push(bool elem)
+	{
+		unsigned shift = nbits % 64;
+		if (shift == 0) {
+			words.push_back(0);
+		}
+
+		words.back() |= static_cast<std::uint64_t>(elem) << shift;
+		nbits++;
+	}
+
+	// һѹ count<= 64Ԫأbits ĵ 0 λѹ룬 count - 1 λΪµջ
+	void push_bits(std::uint64_t bits, unsigned count)
+	{
+		assert(count <= 64);
+		if (count == 0) {
+			return;
+		}
+
+		bits &= mask(count);
+		unsigned shift = nbits % 64;
+		if (shift == 0) {
+			words.push_back(bits);
+		}
+		else {
+			words.back() |= bits << shift;
+			if (shift + count > 64) {
+				words.push_back(bits >> (64 - shift));
+			}
+		}
+
+		nbits += count;
+	}
+
+	void pop()
+	{
+		assert(!empty());
+
+		nbits--;
+		unsigned shift = nbits % 64;
+		if (shift == 0) {
+			words.pop_back();
+		}
+		else {
+			words.back() &= mask(shift);
+		}
+	}
+
+	bool pop_value()
+	{
+		bool elem = top();
+		pop();
+		return elem;
+	}
+
+	// һε count<= 64Ԫأֵλ push_bits ͬ count - 1 λԭջ
+	std::uint64_t pop_bits(unsigned count)
+	{
+		assert(count <= 64 && count <= nbits);
+		if (count == 0) {
+			return 0;
+		}
+
+		std::size_t start = nbits - count;
+		std::size_t word = start / 64;
+		unsigned shift = start % 64;
+
+		std::uint64_t bits = words[word] >> shift;
+		if (shift != 0 && shift + count > 64) {
+			bits |= words[word + 1] << (64 - shift);
+		}
+		bits &= mask(count);
+
+		nbits = start;
+		words.resize((nbits + 63) / 64);
+		if (shift != 0) {
+			words.back() &= mask(shift);
+		}
+
+		return bits;
+	}
+
+	bool top() const
+	{
+		assert(!empty());
+
+		std::size_t i = nbits - 1;
+		return ((words[i / 64] >> (i % 64)) & 1) != 0;
+	}
+
+	bool empty() const
+	{
+		return nbits == 0;
+	}
+
+	std::size_t size() const
+	{
+		return nbits;
+	}
+
+	// λ 0ֱӶÿ popcount 
+	std::size_t count_true() const
+	{
+		std::size_t n = 0;
+		for (auto w : words) {
+			n += popcount64(w);
+		}
+		return n;
+	}
+
+	void printStack() const
+	{
+		for (std::size_t i = 0; i < nbits; i++) {
+			std::cout << (((words[i / 64] >> (i % 64)) & 1) != 0) << std::endl;
+		}
+	}
+
+private:
+	static std::uint64_t mask(unsigned count)
+	{
+		return count >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+	}
+
+private:
+	std::vector<std::uint64_t> words;
+	std::size_t nbits = 0;
+};
+
 // ģƫػػ:ģֵֻͿΪĳЩṩʵ֣ʹ߻Ҫһģ
 template<typename T> 
 class Stack<T*> // һȻǱ T Ǳػָģ壨Stack<T*>
@@ -122,6 +494,16 @@ public:
 		s.pop_back();
 	}
 
+	// ָĿƶpop_value() Զ׳쳣
+	T* pop_value() noexcept
+	{
+		assert(!s.empty());
+
+		T* elem = s.back();
+		s.pop_back();
+		return elem;
+	}
+
 	const T* top()
 	{
 		assert(!s.empty());
@@ -141,10 +523,160 @@ public:
 		}
 	}
 
+	using const_iterator = typename std::vector<T*>::const_iterator;
+
+	const_iterator begin() const
+	{
+		return s.begin();
+	}
+
+	const_iterator end() const
+	{
+		return s.end();
+	}
+
 private:
 	std::vector<T*> s;
 };
 
+// ƫػһ;ͨһǡʹʽѡһʵ֡
+// ջеָ붼ָͬһڴʱ64 λָһ˷ѣֻڳ׵ַ 32 λƫƾ͹ˣ
+// ж󶼰 alignof(T) 룬ƫƵĵͼλ 0 log2(alignof(T)) λѰַķΧ 4G * alignof(T) ֽڡ
+//  Stack<T*> ȣڴͻռöһ룬 top() ͱʱһλͼӷ
+template<typename T>
+struct Compressed; // ֻǣҪ
+
+template<typename T>
+class Stack<Compressed<T*>>
+{
+	// C++11  constexpr ֻһ return 䣬õݹ log2
+	static constexpr unsigned log2(std::size_t n)
+	{
+		return n <= 1 ? 0 : 1 + log2(n / 2);
+	}
+
+	static constexpr unsigned kShift = log2(alignof(T));
+
+public:
+	// base ڴص׵ַ֮ѹָ붼ָ [base, base + 4G * alignof(T)) ֮
+	explicit Stack(const T *base_) : base(reinterpret_cast<const char*>(base_))
+	{
+		std::cout << "-------------- Template Stack Partial Specialization (Compressed) ------------" << std::endl;
+	}
+
+	void push(T* elem)
+	{
+		std::uintptr_t offset = reinterpret_cast<const char*>(elem) - base;
+		assert(offset % alignof(T) == 0 && (offset >> kShift) <= 0xffffffffu);
+
+		s.push_back(static_cast<std::uint32_t>(offset >> kShift));
+	}
+
+	void pop()
+	{
+		assert(!s.empty());
+
+		s.pop_back();
+	}
+
+	T* pop_value() noexcept
+	{
+		assert(!s.empty());
+
+		T* elem = decompress(base, s.back());
+		s.pop_back();
+		return elem;
+	}
+
+	const T* top()
+	{
+		assert(!s.empty());
+
+		return decompress(base, s.back());
+	}
+
+	bool empty() const
+	{
+		return s.empty();
+	}
+
+	void printStack() const
+	{
+		for (auto it : *this) {
+			std::cout << *it << std::endl;
+		}
+	}
+
+	// ʱڽõʱŰƫƻԭָ
+	class const_iterator
+	{
+	public:
+		const_iterator(const std::uint32_t *p_, const char *base_) : p(p_), base(base_)
+		{
+
+		}
+
+		T* operator*() const
+		{
+			return decompress(base, *p);
+		}
+
+		const_iterator& operator++()
+		{
+			++p;
+			return *this;
+		}
+
+		bool operator==(const const_iterator &rhs) const
+		{
+			return p == rhs.p;
+		}
+
+		bool operator!=(const const_iterator &rhs) const
+		{
+			return p != rhs.p;
+		}
+
+	private:
+		const std::uint32_t *p;
+		const char *base;
+	};
+
+	const_iterator begin() const
+	{
+		return const_iterator(s.data(), base);
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(s.data() + s.size(), base);
+	}
+
+private:
+	static T* decompress(const char *base, std::uint32_t offset)
+	{
+		return reinterpret_cast<T*>(const_cast<char*>(base) + (static_cast<std::size_t>(offset) << kShift));
+	}
+
+private:
+	const char *base;
+	std::vector<std::uint32_t> s; // ÿԪֻռ 4 ֽ
+};
+
+// ջָ벢ۼֵָÿԪظ
+template<typename S>
+double traverse(const S &s, std::size_t count, long long &sum)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (int round = 0; round < 5; round++) {
+		for (auto p : s) {
+			sum += *p;
+		}
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return 5.0 * count / elapsed.count() / 1e6;
+}
+
 
 int main()
 {
@@ -165,8 +697,15 @@ int main()
 	s1.push("world ");
 	s1.push(" !");
 
+	std::string str(" again");
+	s1.push(str);
+	s1.emplace(3, '!'); //  std::string(3, '!') ĹԪ
+
 	s1.printStack();
 
+	std::cout << "top() = " << s1.top() << std::endl; // top() ص StringViewַ
+	std::cout << "pop_value() = " << s1.pop_value() << std::endl;
+
 	Stack<int*> s2;
 	int i1 = 10;
 	int i2 = 20;
@@ -179,5 +718,150 @@ int main()
 
 	s2.printStack();
 
+	// ѹָ룺ָ붼ָͬһڴ pool
+	std::vector<int> pool(1 << 20);
+	for (std::size_t i = 0; i < pool.size(); i++) {
+		pool[i] = static_cast<int>(i);
+	}
+
+	Stack<Compressed<int*>> s3(pool.data());
+	s3.push(&pool[10]);
+	s3.push(&pool[20]);
+	s3.printStack();
+
+	// Աȣͬһǧٶָ룬ԭʼָ 8 ֽһѹ 4 ֽһ
+	const std::size_t count = 1 << 24;
+	Stack<int*> raw;
+	Stack<Compressed<int*>> compressed(pool.data());
+	for (std::size_t i = 0; i < count; i++) {
+		int *p = &pool[(i * 2654435761u) & (pool.size() - 1)];
+		raw.push(p);
+		compressed.push(p);
+	}
+
+	long long sum = 0;
+	std::cout << "Stack<int*>             : " << traverse(raw, count, sum) << " M elements/s, "
+			  << count * sizeof(int*) / (1 << 20) << " MB" << std::endl;
+	std::cout << "Stack<Compressed<int*>> : " << traverse(compressed, count, sum) << " M elements/s, "
+			  << count * sizeof(std::uint32_t) / (1 << 20) << " MB" << std::endl;
+	std::cout << "sum = " << sum << std::endl;
+
+	//  8 ~ 40 ַ token std::string  vs ַ
+	const std::size_t tokens = 2000000;
+	std::string token(40, 'x');
+	std::size_t bytes = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::string> strings;
+	for (std::size_t i = 0; i < tokens; i++) {
+		strings.push_back(token.substr(0, 8 + i % 33));
+	}
+	for (const auto &it : strings) {
+		bytes += it.size();
+	}
+	strings.clear();
+	std::chrono::duration<double, std::milli> vectorMs = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	Stack<std::string> arena;
+	for (std::size_t i = 0; i < tokens; i++) {
+		arena.push(token.data(), 8 + i % 33);
+	}
+	while (!arena.empty()) {
+		bytes += arena.top().size();
+		arena.pop();
+	}
+	std::chrono::duration<double, std::milli> arenaMs = std::chrono::steady_clock::now() - start;
+
+	std::cout << "std::vector<std::string> : " << vectorMs.count() << " ms" << std::endl;
+	std::cout << "Stack<std::string>       : " << arenaMs.count() << " ms" << std::endl;
+	std::cout << "bytes = " << bytes << std::endl;
+
+	Stack<bool> flags;
+	flags.push(true);
+	flags.push(false);
+	flags.push_bits(0xf, 4);
+	std::cout << "size = " << flags.size() << ", count_true() = " << flags.count_true()
+			  << ", pop_bits(5) = " << flags.pop_bits(5) << std::endl; // 0b11110 = 30
+
+	// Stack<bool>  Stack<char> ĶԱȣѹ 6400 Ԫأͳ true ĸȫ
+	const std::size_t nbools = 64 * 1000000;
+	std::size_t trues = 0;
+
+	start = std::chrono::steady_clock::now();
+	Stack<char> chars;
+	for (std::size_t i = 0; i < nbools; i++) {
+		chars.push((i * 7) % 3 == 0);
+	}
+	while (!chars.empty()) {
+		trues += chars.top() != 0;
+		chars.pop();
+	}
+	std::chrono::duration<double, std::milli> charMs = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	Stack<bool> bits;
+	for (std::size_t i = 0; i < nbools; i++) {
+		bits.push((i * 7) % 3 == 0);
+	}
+	trues += bits.count_true();
+	while (!bits.empty()) {
+		bits.pop();
+	}
+	std::chrono::duration<double, std::milli> bitMs = std::chrono::steady_clock::now() - start;
+
+	// ֲÿѹ/ 64 Ԫ
+	start = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < nbools / 64; i++) {
+		bits.push_bits(0x9249249249249249ull, 64);
+	}
+	trues += bits.count_true();
+	while (!bits.empty()) {
+		bits.pop_bits(64);
+	}
+	std::chrono::duration<double, std::milli> wordMs = std::chrono::steady_clock::now() - start;
+
+	std::cout << "Stack<char>                 : " << charMs.count() << " ms, " << nbools / (1 << 20) << " MB" << std::endl;
+	std::cout << "Stack<bool>                 : " << bitMs.count() << " ms, " << nbools / 8 / (1 << 20) << " MB" << std::endl;
+	std::cout << "Stack<bool> push/pop_bits   : " << wordMs.count() << " ms" << std::endl;
+	std::cout << "trues = " << trues << std::endl;
+
+	// һǧ int ֳ 1000 һѹ룬ÿȡջ 1000 ͺ󵯳
+	const std::size_t nints = 10000000;
+	const std::size_t burst = 1000;
+	std::vector<int> input(nints);
+	for (std::size_t i = 0; i < nints; i++) {
+		input[i] = static_cast<int>(i & 0xff);
+	}
+	long long total = 0;
+
+	start = std::chrono::steady_clock::now();
+	Stack<int> one;
+	for (std::size_t i = 0; i < nints; i++) {
+		one.push(input[i]);
+	}
+	while (!one.empty()) {
+		total += one.top();
+		one.pop();
+	}
+	std::chrono::duration<double, std::milli> oneMs = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	Stack<int> batched;
+	for (std::size_t i = 0; i < nints; i += burst) {
+		batched.push_range(input.data() + i, input.data() + i + burst);
+	}
+	while (!batched.empty()) {
+		for (int v : batched.top_n(burst)) {
+			total += v;
+		}
+		batched.pop_n(burst);
+	}
+	std::chrono::duration<double, std::milli> batchMs = std::chrono::steady_clock::now() - start;
+
+	std::cout << "push/top/pop              : " << oneMs.count() << " ms" << std::endl;
+	std::cout << "push_range/top_n/pop_n    : " << batchMs.count() << " ms" << std::endl;
+	std::cout << "total = " << total << std::endl;
+
 	return 0;
 }
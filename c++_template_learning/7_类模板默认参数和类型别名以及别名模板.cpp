@@ -2,6 +2,8 @@
 #include <vector>
 #include <cassert>
 #include <deque>
+#include <utility>
+#include <type_traits>
 
 /* ģĬϲͱԼģ壨ģAlias Templates-- stack Ϊ */
 
@@ -22,6 +24,17 @@ public:
 		s.push_back(elem);
 	}
 
+	void push(T &&elem)
+	{
+		s.push_back(std::move(elem));
+	}
+
+	template<typename... Args>
+	void emplace(Args&&... args)
+	{
+		s.emplace_back(std::forward<Args>(args)...);
+	}
+
 	void pop()
 	{
 		assert(!s.empty());
@@ -29,6 +42,15 @@ public:
 		s.pop_back();
 	}
 
+	T pop_value() noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		assert(!s.empty());
+
+		T elem(std::move(s.back()));
+		s.pop_back();
+		return elem;
+	}
+
 	const T& top()
 	{
 		assert(!s.empty());
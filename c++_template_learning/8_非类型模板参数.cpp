@@ -1,5 +1,52 @@
 #include <iostream>
 #include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <type_traits>
+
+// C++14 лû std::spanһ򵥵ͼ棺ָֻͳȣӵԪ
+template<typename T>
+class Span
+{
+public:
+	Span(T *data_, std::size_t size_) : ptr(data_), len(size_)
+	{
+
+	}
+
+	T* data() const
+	{
+		return ptr;
+	}
+
+	std::size_t size() const
+	{
+		return len;
+	}
+
+	T* begin() const
+	{
+		return ptr;
+	}
+
+	T* end() const
+	{
+		return ptr + len;
+	}
+
+	T& operator[](std::size_t i) const
+	{
+		return ptr[i];
+	}
+
+private:
+	T *ptr;
+	std::size_t len;
+};
 
 // ںģģ壬ģһǵĳ־ͣҲǳֵ
 // ԷģĲͣĳֵ
@@ -17,18 +64,70 @@ public:
 		nums++;
 	}
 
+	// ԪѾĬϹˣֻƶֵ
+	void push(T &&elem) noexcept(std::is_nothrow_move_assignable<T>::value)
+	{
+		assert(nums < Size);
+
+		s[nums] = std::move(elem);
+		nums++;
+	}
+
+	template<typename... Args>
+	void emplace(Args&&... args) noexcept(std::is_nothrow_constructible<T, Args&&...>::value && std::is_nothrow_move_assignable<T>::value)
+	{
+		push(T(std::forward<Args>(args)...));
+	}
+
+	// ѹ [first, last)ǹ̶ģֻҪһΣ
+	// ڿƽ Tָ T ֱָ memcpyָ͵ָ룬 short* ѹ Stack<int>תֵ
+	template<typename InputIt>
+	void push_range(InputIt first, InputIt last)
+	{
+		int n = static_cast<int>(std::distance(first, last));
+		assert(nums + n <= Size);
+
+		using Source = typename std::remove_cv<typename std::iterator_traits<InputIt>::value_type>::type;
+		copyRange(first, last, s + nums, std::integral_constant<bool, std::is_pointer<InputIt>::value
+			&& std::is_same<Source, T>::value && std::is_trivially_copyable<T>::value>());
+		nums += n;
+	}
+
 	void pop()
 	{
 		assert( !isEmpty() );
 		nums--;
 	}
 
+	// һε n ԪءеԪ Stack ʱŻ
+	//  std::string ԴͣΪ T()ʱͷռõڴ
+	void pop_n(int n)
+	{
+		assert(n <= nums);
+		nums -= n;
+		releaseRange(s + nums, s + nums + n, std::is_trivially_destructible<T>());
+	}
+
+	T pop_value() noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		assert(!isEmpty());
+		nums--;
+		return std::move(s[nums]);
+	}
+
 	const T& top()
 	{
 		assert(!isEmpty());
 		return s[ nums - 1 ];
 	}
 
+	// ջ n Ԫأϵ˳򣩣
+	Span<const T> top_n(int n) const
+	{
+		assert(n <= nums);
+		return Span<const T>(s + (nums - n), static_cast<std::size_t>(n));
+	}
+
 	bool isEmpty() const
 	{
 		return nums == 0;
@@ -46,6 +145,31 @@ public:
 		}
 	}
 
+private:
+	template<typename InputIt>
+	static void copyRange(InputIt first, InputIt last, T *dest, std::true_type)
+	{
+		if (first != last) {
+			std::memcpy(dest, first, static_cast<std::size_t>(last - first) * sizeof(T));
+		}
+	}
+
+	template<typename InputIt>
+	static void copyRange(InputIt first, InputIt last, T *dest, std::false_type)
+	{
+		std::copy(first, last, dest);
+	}
+
+	static void releaseRange(T *, T *, std::true_type)
+	{
+
+	}
+
+	static void releaseRange(T *first, T *last, std::false_type)
+	{
+		std::fill(first, last, T());
+	}
+
 private:
 	int nums = 0;
 	T s[Size];
@@ -64,5 +188,21 @@ int main()
 	}
 	stack.printStack();
 
+	// 
+	int more[] = { 60, 70, 80 };
+	stack.push_range(more, more + 3);
+	for (int v : stack.top_n(4)) {
+		std::cout << v << " ";
+	}
+	std::cout << std::endl;
+	stack.pop_n(6);
+	stack.printStack();
+
+	Stack<std::string, 8> words;
+	std::string text[] = { "push_range", "top_n", "pop_n" };
+	words.push_range(std::begin(text), std::end(text));
+	words.pop_n(2);
+	words.printStack();
+
 	return 0;
 }
\ No newline at end of file
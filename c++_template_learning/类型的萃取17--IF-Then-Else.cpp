@@ -1,4 +1,9 @@
 #include <iostream>
+#include <array>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+#include <limits>
 #include <type_traits>
 
 // ǿһģ IfThenElse һ if-then-else Ϊ
@@ -23,15 +28,16 @@ struct IfThenElseT<false, TrueType, FalseType>
 template<bool COND, typename TrueType, typename FalseType>
 using IfThenElse = typename IfThenElseT<COND, TrueType, FalseType>::Type;
 
-// 
-template<auto N> 
+// ҳܹʾ N С
+// template<auto N> Ҫ C++17 ʹã unsigned long long Ϊģͣ
+template<unsigned long long N> 
 struct SmallestIntT
 {
-	typename IfThenElseT<N <= std::numeric_limits<char>::max(), char,
+	using Type = typename IfThenElseT<N <= std::numeric_limits<char>::max(), char,
 		typename IfThenElseT<N <= std::numeric_limits<short>::max(), short, 
 			typename IfThenElseT<N <= std::numeric_limits<int>::max(), int, 
 				typename IfThenElseT<N <= std::numeric_limits<long>::max(), long, 
-					typename IfThenElseT<N <= std::numeric_limits<long long>::max(), long long, //then void //fallback 
+					typename IfThenElseT<N <= std::numeric_limits<long long>::max(), long long, void // Ųʱ void
 					>::Type 
 				>::Type 
 			>::Type 
@@ -39,11 +45,101 @@ struct SmallestIntT
 	>::Type;
 };
 
+template<unsigned long long N>
+using SmallestInt = typename SmallestIntT<N>::Type;
+
+// Ӧãѡۼ N  char ʱխۼ͡
+// ͨʱ char ᱻչΪ intAccumulateTrait<char>::AccT  intһ 256 λ AVX2 Ĵֻܷ 8  int
+//  std::array<char, N>͵ľֵ N * 128char ޷ʱ N * 255ڱھ֪ˣ
+// N  255 ʱ short ͹ˣһĴԷ 16  short֮ÿָԪضһ
+constexpr unsigned long long kCharMagnitude = std::is_signed<char>::value ? 128 : 255; //  char ֵ
+
+template<std::size_t N>
+using NarrowAccT = SmallestInt<N * kCharMagnitude>;
+
+template<typename AccT, std::size_t N>
+AccT sumChars(const char *p)
+{
+	AccT total = 0;
+	for (std::size_t i = 0; i < N; i++) {
+		total = static_cast<AccT>(total + p[i]); //  NarrowAccT ֤
+	}
+	return total;
+}
+
+template<std::size_t N>
+NarrowAccT<N> accum(const std::array<char, N> &a)
+{
+	return sumChars<NarrowAccT<N>, N>(a.data());
+}
+
+// ʱ֪ʱг kTile һ飺ÿһ short ۼӣkTile ǲ short ޵ 16 ı
+// ÿһĽټӵ long long ܺ
+constexpr std::size_t kTile = std::numeric_limits<short>::max() / kCharMagnitude / 16 * 16;
+static_assert(std::is_same<NarrowAccT<kTile>, short>::value, "a tile must fit in short");
+
+inline long long accumTiled(const char *beg, const char *end)
+{
+	long long total = 0;
+	while (static_cast<std::size_t>(end - beg) >= kTile) {
+		total += sumChars<short, kTile>(beg);
+		beg += kTile;
+	}
+	while (beg != end) {
+		total += *beg;
+		++beg;
+	}
+	return total;
+}
+
+// Աȣ AccumulateTrait<char> ÿ char չΪ int 
+inline long long accumWide(const char *beg, const char *end)
+{
+	int total = 0;
+	while (beg != end) {
+		total += *beg;
+		++beg;
+	}
+	return total;
+}
+
 //  C++׼ IfThenElseT ģӦģ壨std::conditional<>;
 
 int main()
 {
 	SmallestIntT<10>();
+	static_assert(std::is_same<SmallestInt<100>, char>::value || !std::is_signed<char>::value, "");
+	static_assert(std::is_same<SmallestInt<1000>, short>::value, "");
+	static_assert(std::is_same<SmallestInt<100000>, int>::value, "");
+
+	std::array<char, 200> small;
+	small.fill(-100);
+	std::cout << "accum(std::array<char, 200>) = " << accum(small) << ", accumulator is " << sizeof(NarrowAccT<200>) << " bytes" << std::endl;
+
+	// 8 MB  charͲᳬ int ķΧ 128 
+	std::vector<char> data(std::size_t(8) << 20);
+	for (std::size_t i = 0; i < data.size(); i++) {
+		data[i] = static_cast<char>((i * 2654435761u) >> 24) & 0x7f;
+	}
+	const char *beg = data.data();
+	const char *end = beg + data.size();
+	const int rounds = 128;
+	long long r1 = 0, r2 = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++) {
+		r1 += accumWide(beg + r, end);
+	}
+	std::chrono::duration<double, std::milli> wideMs = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++) {
+		r2 += accumTiled(beg + r, end);
+	}
+	std::chrono::duration<double, std::milli> tiledMs = std::chrono::steady_clock::now() - start;
+
+	std::cout << "int accumulator   (" << 32 / sizeof(int) << " lanes per AVX2 register) : " << wideMs.count() << " ms, sum = " << r1 << std::endl;
+	std::cout << "short tiles of " << kTile << " (" << 32 / sizeof(short) << " lanes per AVX2 register) : " << tiledMs.count() << " ms, sum = " << r2 << std::endl;
 
 	return 0;
 }
\ No newline at end of file
@@ -1,4 +1,13 @@
 #include <iostream>
+#include <fstream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <utility>
+#include <type_traits>
 
 // ĿǰΪֹǿȡĶض͵ĶϢ
 // ʵһϢϢԽԼֵһ͹
@@ -100,6 +109,11 @@ public:
 		return MyType(x.a + a, x.b + b, x.c + c);
 	}
 
+	int field(std::size_t i) const
+	{
+		return i == 0 ? a : (i == 1 ? b : c);
+	}
+
 	void print() const
 	{
 		std::cout << "a = " << a << std::endl;
@@ -216,6 +230,379 @@ auto accum2(T const* beg, T const* end)
 	return total;
 }
 
+// accum2() ҪΪһڴݰ߰ӱڴ滹ļжʱ
+// ԰ۻ״̬һУÿһ feed() һΣȡ result()
+
+// C++14 лû std::spanһ򵥵ͼ棺ָֻͳȣӵԪ
+template<typename T>
+class Span
+{
+public:
+	Span(T *data_, std::size_t size_) : ptr(data_), len(size_)
+	{
+
+	}
+
+	T* data() const
+	{
+		return ptr;
+	}
+
+	std::size_t size() const
+	{
+		return len;
+	}
+
+	T* begin() const
+	{
+		return ptr;
+	}
+
+	T* end() const
+	{
+		return ptr + len;
+	}
+
+private:
+	T *ptr;
+	std::size_t len;
+};
+
+// ۻͣ
+class SumPolicy
+{
+public:
+	template<typename T1, typename T2>
+	static void accumulate(T1& total, T2 const& value)
+	{
+		total += value;
+	}
+};
+
+// ֵʼֵ 0ԲԼṩ identity()ۻĵλԪ
+class MultPolicy
+{
+public:
+	template<typename T1>
+	static constexpr T1 identity()
+	{
+		return 1;
+	}
+
+	template<typename T1, typename T2>
+	static void accumulate(T1& total, T2 const& value)
+	{
+		total *= value;
+	}
+};
+
+class MaxPolicy
+{
+public:
+	template<typename T1>
+	static constexpr T1 identity()
+	{
+		return std::numeric_limits<T1>::lowest();
+	}
+
+	template<typename T1, typename T2>
+	static void accumulate(T1& total, T2 const& value)
+	{
+		if (total < value) {
+			total = value;
+		}
+	}
+};
+
+// ʼֵṩ identity<AccT>() ʱ˻صȡ zero() ȡʵ4 еͬ
+template<typename Policy, typename Traits>
+auto initialValue(int) -> decltype(Policy::template identity<typename Traits::AccT>())
+{
+	return Policy::template identity<typename Traits::AccT>();
+}
+
+template<typename Policy, typename Traits>
+typename Traits::AccT initialValue(long)
+{
+	return Traits::zero();
+}
+
+// ϲֽṩ combine(total, partial) ʱҪּӣ˻ص accumulate
+template<typename Policy, typename AccT>
+auto combineResults(AccT &total, AccT const& partial, int) -> decltype(Policy::combine(total, partial), void())
+{
+	Policy::combine(total, partial);
+}
+
+template<typename Policy, typename AccT>
+void combineResults(AccT &total, AccT const& partial, long)
+{
+	Policy::accumulate(total, partial);
+}
+
+// AccumulatorԷֿ롢ԺϲۻAccT  AccumulateTrait2ʼֵ initialValue()
+// Ҫһfeed()  4 ໥Ĳֽۻ total += *beg Ҳװ
+//         ÿֽӳʼֵλԪʼ combineResults ϲ total
+// Ҫmerge() ͬ combineResults ϲһۻĽ̸߳ feed һݣϲɣ
+// Ҫ㶼Ҫ Policy ɺͽɣ͡/Сֵ㣩
+//         ҳʼֵȷʵǵλԪȡ zero() ɣ/СֵĲԱṩ identity()
+template<typename T, typename Policy = SumPolicy, typename Traits = AccumulateTrait2<T>>
+class Accumulator
+{
+public:
+	using AccT = typename Traits::AccT;
+
+	Accumulator() : total(initialValue<Policy, Traits>(0)), count(0)
+	{
+
+	}
+
+	void feed(Span<const T> chunk)
+	{
+		const T *p = chunk.data();
+		const std::size_t n = chunk.size();
+		const std::size_t full = n / 4 * 4;
+
+		const AccT init = initialValue<Policy, Traits>(0);
+		AccT lanes[4] = { init, init, init, init };
+		for (std::size_t i = 0; i < full; i += 4) {
+			Policy::accumulate(lanes[0], p[i]);
+			Policy::accumulate(lanes[1], p[i + 1]);
+			Policy::accumulate(lanes[2], p[i + 2]);
+			Policy::accumulate(lanes[3], p[i + 3]);
+		}
+		for (std::size_t i = full; i < n; i++) {
+			Policy::accumulate(lanes[0], p[i]);
+		}
+
+		for (int k = 0; k < 4; k++) {
+			combineResults<Policy>(total, lanes[k], 0);
+		}
+		count += n;
+	}
+
+	void feed(T const* beg, T const* end)
+	{
+		feed(Span<const T>(beg, static_cast<std::size_t>(end - beg)));
+	}
+
+	void merge(const Accumulator &other)
+	{
+		combineResults<Policy>(total, other.total, 0);
+		count += other.count;
+	}
+
+	AccT result() const
+	{
+		return total;
+	}
+
+	// ĿǰΪֹԪظ
+	std::size_t size() const
+	{
+		return count;
+	}
+
+	void reset()
+	{
+		total = initialValue<Policy, Traits>(0);
+		count = 0;
+	}
+
+private:
+	AccT total;
+	std::size_t count;
+};
+
+// MyType  operator+=  const ģ޸ǷһµĶ accum2() е total += *beg ʵʲôҲûиı䣻
+// ҪõȷĽֻд total = (total += *beg)ÿԪضҪ졢һʱѭҲ޷
+// һȡ T Ƿṩ U Ϊ͵޸ġ operator+= T&پݴѡۼӵд
+template<typename...>
+using VoidT = void;
+
+template<typename T, typename U = T, typename = VoidT<>>
+struct HasInPlaceAddT : std::false_type
+{
+
+};
+
+template<typename T, typename U>
+struct HasInPlaceAddT<T, U, VoidT<decltype(std::declval<T&>() += std::declval<U const&>())>>
+	: std::is_same<decltype(std::declval<T&>() += std::declval<U const&>()), T&>
+{
+
+};
+
+template<typename AccT, typename T>
+void addTo(AccT &total, T const& value, std::true_type)
+{
+	total += value; // ͵޸
+}
+
+template<typename AccT, typename T>
+void addTo(AccT &total, T const& value, std::false_type)
+{
+	total = (total += value); // operator+= ¶ֻٸֵȥ
+}
+
+// ṹ飨AoS, array of structuresʱۼ
+template<typename T>
+auto accum3(T const* beg, T const* end)
+{
+	using AccT = typename AccumulateTrait2<T>::AccT;
+	AccT total = AccumulateTrait2<T>::zero();
+
+	while (beg != end) {
+		addTo(total, *beg, HasInPlaceAddT<AccT, T>());
+		++beg;
+	}
+
+	return total;
+}
+
+// ɸֶͬɵľۺͣõǰдţSoA, structure of arrays
+// ÿֶεһУۼʱͣÿһж򵥵 int ѭֱ
+// FieldTrait<T> һ͵ֶΣֶε͡ȡ i ֶΡɸֶ¹ T
+// ģʲôҲûУûػ FieldTrait Ͳܰд
+template<typename T>
+struct FieldTrait
+{
+
+};
+
+template<typename T, typename = VoidT<>>
+struct HasFieldsT : std::false_type
+{
+
+};
+
+template<typename T>
+struct HasFieldsT<T, VoidT<typename FieldTrait<T>::FieldT>> : std::true_type
+{
+
+};
+
+template<>
+struct FieldTrait<MyType>
+{
+	using FieldT = int;
+	static constexpr std::size_t count = 3;
+
+	static FieldT get(const MyType &x, std::size_t i)
+	{
+		return x.field(i);
+	}
+
+	static MyType make(const FieldT *fields)
+	{
+		return MyType(fields[0], fields[1], fields[2]);
+	}
+};
+
+template<typename T, typename Fields = FieldTrait<T>>
+class Columns
+{
+public:
+	using value_type = T;
+	using FieldT = typename Fields::FieldT;
+
+	void push_back(const T &x)
+	{
+		for (std::size_t i = 0; i < Fields::count; i++) {
+			cols[i].push_back(Fields::get(x, i));
+		}
+	}
+
+	std::size_t size() const
+	{
+		return cols[0].size();
+	}
+
+	const FieldT* column(std::size_t i) const
+	{
+		return cols[i].data();
+	}
+
+	// о͵ۼӣɸеĺ͹
+	T sum() const
+	{
+		FieldT sums[Fields::count];
+		for (std::size_t i = 0; i < Fields::count; i++) {
+			FieldT total = 0;
+			const FieldT *p = cols[i].data();
+			const std::size_t n = cols[i].size();
+			for (std::size_t j = 0; j < n; j++) {
+				total += p[j];
+			}
+			sums[i] = total;
+		}
+		return Fields::make(sums);
+	}
+
+private:
+	std::vector<FieldT> cols[Fields::count];
+};
+
+// ȡ¼ĴŷʽֶεͰдţȻ std::vector<T>ۼʱþ͵ص +=ûеĻ˻ص
+template<typename T>
+using RecordArray = typename std::conditional<HasFieldsT<T>::value, Columns<T>, std::vector<T>>::type;
+
+template<typename T, typename Fields>
+T accum3(const Columns<T, Fields> &records)
+{
+	return records.sum();
+}
+
+template<typename T>
+auto accum3(const std::vector<T> &records)
+{
+	return accum3(records.data(), records.data() + records.size());
+}
+
+// ܶԱȵļ¼ͣ MyType һ int operator+= Ǿ͵޸ĵģҲӡ
+struct Triple
+{
+	int a;
+	int b;
+	int c;
+
+	Triple& operator+=(const Triple &x)
+	{
+		a += x.a;
+		b += x.b;
+		c += x.c;
+		return *this;
+	}
+};
+
+template<>
+struct AccumulateTrait2<Triple>
+{
+	using AccT = Triple;
+
+	static constexpr AccT zero()
+	{
+		return AccT{ 0, 0, 0 };
+	}
+};
+
+template<>
+struct FieldTrait<Triple>
+{
+	using FieldT = int;
+	static constexpr std::size_t count = 3;
+
+	static FieldT get(const Triple &x, std::size_t i)
+	{
+		return i == 0 ? x.a : (i == 1 ? x.b : x.c);
+	}
+
+	static Triple make(const FieldT *fields)
+	{
+		return Triple{ fields[0], fields[1], fields[2] };
+	}
+};
+
 int main()
 {
 
@@ -234,6 +621,110 @@ int main()
 	MyType ret = accum2(a, a + 3 );
 	ret.print();
 
+	//  6400  int256 MBдļٰ 64 KB һ߶ۻڴֻһĻ
+	//  -500 ~ 500 ֮ѭܺͽӽ 0Windows  AccumulateTrait<int>::AccTlongֻ 32 λ
+	const char *path = "accumulator.bin";
+	const std::size_t n = std::size_t(64) << 20;
+	const std::size_t chunk = 16 * 1024;
+	std::vector<int> buffer(chunk);
+	{
+		std::ofstream out(path, std::ios::binary);
+		for (std::size_t i = 0; i < n; i += chunk) {
+			for (std::size_t j = 0; j < chunk; j++) {
+				buffer[j] = static_cast<int>((i + j) % 1001) - 500;
+			}
+			out.write(reinterpret_cast<const char*>(buffer.data()), chunk * sizeof(int));
+		}
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	Accumulator<int> streamed;
+	{
+		std::ifstream in(path, std::ios::binary);
+		while (in.read(reinterpret_cast<char*>(buffer.data()), chunk * sizeof(int)) || in.gcount() > 0) {
+			std::size_t got = static_cast<std::size_t>(in.gcount()) / sizeof(int);
+			streamed.feed(Span<const int>(buffer.data(), got));
+		}
+	}
+	std::chrono::duration<double, std::milli> streamMs = std::chrono::steady_clock::now() - start;
+	std::remove(path);
+
+	// ͬݷڴУ̸߳ۻһ룬 merge()
+	std::vector<int> data(n);
+	for (std::size_t i = 0; i < n; i++) {
+		data[i] = static_cast<int>(i % 1001) - 500;
+	}
+
+	start = std::chrono::steady_clock::now();
+	long whole = accum2(data.data(), data.data() + n);
+	std::chrono::duration<double, std::milli> accumMs = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	Accumulator<int> left;
+	Accumulator<int> right;
+	std::thread worker([&]() { right.feed(data.data() + n / 2, data.data() + n); });
+	left.feed(data.data(), data.data() + n / 2);
+	worker.join();
+	left.merge(right);
+	std::chrono::duration<double, std::milli> mergeMs = std::chrono::steady_clock::now() - start;
+
+	std::cout << "accum2()                  : " << whole << ", " << accumMs.count() << " ms" << std::endl;
+	std::cout << "Accumulator, 64 KB chunks : " << streamed.result() << ", " << streamed.size() << " elements, "
+			  << streamMs.count() << " ms (including file reads)" << std::endl;
+	std::cout << "Accumulator, 2 threads    : " << left.result() << ", " << mergeMs.count() << " ms" << std::endl;
+
+	// ֵÿͨӲԵĵλԪʼһ 0
+	int negatives[] = { -3, -2, -5, -1, -4 };
+	Accumulator<int, MultPolicy> product;
+	Accumulator<int, MaxPolicy> maximum;
+	product.feed(negatives, negatives + 5);
+	maximum.feed(negatives, negatives + 5);
+	std::cout << "Accumulator, product = " << product.result() << ", max = " << maximum.result() << std::endl;
+
+	// MyTypeRecordArray<MyType> дţʱٵ const  operator+=
+	RecordArray<MyType> columns;
+	for (int i = 0; i < 3; i++) {
+		columns.push_back(MyType(1, 3, 4));
+	}
+	accum3(columns).print();
+
+	// 1600  Tripleṹ vs д
+	const std::size_t records = std::size_t(16) << 20;
+	std::vector<Triple> aos;
+	RecordArray<Triple> soa;
+	aos.reserve(records);
+	for (std::size_t i = 0; i < records; i++) {
+		Triple t{ static_cast<int>(i % 7), static_cast<int>(i % 11), static_cast<int>(i % 13) };
+		aos.push_back(t);
+		soa.push_back(t);
+	}
+
+	start = std::chrono::steady_clock::now();
+	Triple aosSum = accum3(aos);
+	std::chrono::duration<double, std::milli> aosMs = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	Triple soaSum = accum3(soa);
+	std::chrono::duration<double, std::milli> soaMs = std::chrono::steady_clock::now() - start;
+
+	std::cout << "AoS std::vector<Triple> : " << aosMs.count() << " ms, sum = {" << aosSum.a << ", " << aosSum.b << ", " << aosSum.c << "}" << std::endl;
+	std::cout << "SoA Columns<Triple>     : " << soaMs.count() << " ms, sum = {" << soaSum.a << ", " << soaSum.b << ", " << soaSum.c << "}" << std::endl;
+
+	// ֻҪһֶʱдֻȡ֮һڴ
+	start = std::chrono::steady_clock::now();
+	long long aosA = 0;
+	for (const auto &it : aos) {
+		aosA += it.a;
+	}
+	std::chrono::duration<double, std::milli> aosFieldMs = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	long soaA = accum2(soa.column(0), soa.column(0) + soa.size());
+	std::chrono::duration<double, std::milli> soaFieldMs = std::chrono::steady_clock::now() - start;
+
+	std::cout << "AoS field a only        : " << aosFieldMs.count() << " ms, sum = " << aosA << std::endl;
+	std::cout << "SoA column a only       : " << soaFieldMs.count() << " ms, sum = " << soaA << std::endl;
+
 	return 0;
 }
 
@@ -1,4 +1,21 @@
 #include <iostream>
+#include <vector>
+#include <chrono>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ACCUM_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#ifdef __AVX2__
+#define ACCUM_USE_AVX2 1
+#include <immintrin.h>
+#endif
 
 // ǰ漸У accum()ʹõȡΪ̶ģfixedΪһ˽ȡ
 // 㷨ͲԱ滻ĳЩ£һдoverridingΪȴġ
@@ -60,9 +77,571 @@ struct AccumulateTrait<float>
 };
 
 
+// ۼӵѭ AccumKernel<T, AccT> УģԭԪչӵѭ
+//  AccumulateTrait ÿһػ SSE2/AVX2 ػİ汾һδ 16/32 ֽڣʣµβȻӡ
+// İ汾ͬչchar/short -> intint -> longfloat -> doubleĽȫһ£
+// float -> double İ汾ıӵ˳΢СĲ
+template<typename T, typename AccT>
+struct AccumKernel
+{
+	static AccT run(const T *beg, const T *end, AccT total)
+	{
+		while (beg != end) {
+			total += *beg;
+			++beg;
+		}
+
+		return total;
+	}
+};
+
+#ifdef ACCUM_USE_SSE2
+inline std::uint64_t hsumEpi64(__m128i v)
+{
+	alignas(16) std::uint64_t t[2];
+	_mm_store_si128(reinterpret_cast<__m128i*>(t), v);
+	return t[0] + t[1];
+}
+
+inline std::uint32_t hsumEpi32(__m128i v)
+{
+	alignas(16) std::uint32_t t[4];
+	_mm_store_si128(reinterpret_cast<__m128i*>(t), v);
+	return t[0] + t[1] + t[2] + t[3];
+}
+
+inline double hsumPd(__m128d v)
+{
+	alignas(16) double t[2];
+	_mm_store_pd(t, v);
+	return t[0] + t[1];
+}
+
+#ifdef ACCUM_USE_AVX2
+inline std::uint64_t hsumEpi64(__m256i v)
+{
+	return hsumEpi64(_mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+}
+
+inline std::uint32_t hsumEpi32(__m256i v)
+{
+	return hsumEpi32(_mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+}
+
+inline double hsumPd(__m256d v)
+{
+	return hsumPd(_mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1)));
+}
+#endif
+
+//  32 λչΪ 64 λͣSigned չչ i Ϊֹʣµβ
+template<bool Signed>
+std::uint64_t sumInt32To64(const void *p, std::size_t n, std::size_t &i)
+{
+	const std::int32_t *src = static_cast<const std::int32_t*>(p);
+	std::uint64_t sum = 0;
+#ifdef ACCUM_USE_AVX2
+	__m256i acc8 = _mm256_setzero_si256();
+	for (; i + 4 <= n; i += 4) {
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		acc8 = _mm256_add_epi64(acc8, Signed ? _mm256_cvtepi32_epi64(v) : _mm256_cvtepu32_epi64(v));
+	}
+	sum += hsumEpi64(acc8);
+#endif
+	__m128i acc = _mm_setzero_si128();
+	for (; i + 4 <= n; i += 4) {
+		__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		__m128i high = Signed ? _mm_srai_epi32(v, 31) : _mm_setzero_si128(); // չĸ 32 λ
+		acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, high));
+		acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, high));
+	}
+	return sum + hsumEpi64(acc);
+}
+
+// 32 λ 32 λͣƵĽһ£
+inline std::uint32_t sumInt32To32(const void *p, std::size_t n, std::size_t &i)
+{
+	const std::int32_t *src = static_cast<const std::int32_t*>(p);
+	std::uint32_t sum = 0;
+#ifdef ACCUM_USE_AVX2
+	__m256i acc8 = _mm256_setzero_si256();
+	for (; i + 8 <= n; i += 8) {
+		acc8 = _mm256_add_epi32(acc8, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+	}
+	sum += hsumEpi32(acc8);
+#endif
+	__m128i acc = _mm_setzero_si128();
+	for (; i + 4 <= n; i += 4) {
+		acc = _mm_add_epi32(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+	}
+	return sum + hsumEpi32(acc);
+}
+
+// char -> intpsadbw ÿ 8 ޷ֽڼӳһ 64 λĺͣ
+// char зʱ 0x80 [-128, 127] ƽƵ [0, 255]ټȥ 128 * ֽ
+template<>
+struct AccumKernel<char, int>
+{
+	static int run(const char *beg, const char *end, int total)
+	{
+		const bool isSigned = std::is_signed<char>::value;
+		std::size_t n = static_cast<std::size_t>(end - beg);
+		std::size_t i = 0;
+		std::uint64_t sum = 0;
+#ifdef ACCUM_USE_AVX2
+		const __m256i bias8 = _mm256_set1_epi8(isSigned ? static_cast<char>(0x80) : 0);
+		__m256i acc8 = _mm256_setzero_si256();
+		for (; i + 32 <= n; i += 32) {
+			__m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(beg + i)), bias8);
+			acc8 = _mm256_add_epi64(acc8, _mm256_sad_epu8(v, _mm256_setzero_si256()));
+		}
+		sum += hsumEpi64(acc8);
+#endif
+		const __m128i bias = _mm_set1_epi8(isSigned ? static_cast<char>(0x80) : 0);
+		__m128i acc = _mm_setzero_si128();
+		for (; i + 16 <= n; i += 16) {
+			__m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(beg + i)), bias);
+			acc = _mm_add_epi64(acc, _mm_sad_epu8(v, _mm_setzero_si128()));
+		}
+		sum += hsumEpi64(acc);
+		if (isSigned) {
+			sum -= 128 * static_cast<std::uint64_t>(i);
+		}
+
+		total = static_cast<int>(static_cast<std::uint32_t>(total) + static_cast<std::uint32_t>(sum));
+		for (; i < n; i++) {
+			total += beg[i];
+		}
+		return total;
+	}
+};
+
+// short -> intpmaddwd  16 λ 1 ӣõ 32 λĺ
+template<>
+struct AccumKernel<short, int>
+{
+	static int run(const short *beg, const short *end, int total)
+	{
+		std::size_t n = static_cast<std::size_t>(end - beg);
+		std::size_t i = 0;
+		std::uint32_t sum = 0;
+#ifdef ACCUM_USE_AVX2
+		const __m256i ones8 = _mm256_set1_epi16(1);
+		__m256i acc8 = _mm256_setzero_si256();
+		for (; i + 16 <= n; i += 16) {
+			__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(beg + i));
+			acc8 = _mm256_add_epi32(acc8, _mm256_madd_epi16(v, ones8));
+		}
+		sum += hsumEpi32(acc8);
+#endif
+		const __m128i ones = _mm_set1_epi16(1);
+		__m128i acc = _mm_setzero_si128();
+		for (; i + 8 <= n; i += 8) {
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(beg + i));
+			acc = _mm_add_epi32(acc, _mm_madd_epi16(v, ones));
+		}
+		sum += hsumEpi32(acc);
+
+		total = static_cast<int>(static_cast<std::uint32_t>(total) + sum);
+		for (; i < n; i++) {
+			total += beg[i];
+		}
+		return total;
+	}
+};
+
+// int -> longlong  LP64Linux/macOS 64 λҪȷչ LLP64Windows int һ 32 λ
+template<>
+struct AccumKernel<int, long>
+{
+	static long run(const int *beg, const int *end, long total)
+	{
+		std::size_t n = static_cast<std::size_t>(end - beg);
+		std::size_t i = 0;
+		if (sizeof(long) == 8) {
+			total = static_cast<long>(static_cast<std::uint64_t>(total) + sumInt32To64<true>(beg, n, i));
+		}
+		else {
+			total = static_cast<long>(static_cast<std::uint32_t>(total) + sumInt32To32(beg, n, i));
+		}
+
+		for (; i < n; i++) {
+			total += beg[i];
+		}
+		return total;
+	}
+};
+
+// unsigned int -> unsigned longͬϣֻչ
+template<>
+struct AccumKernel<unsigned int, unsigned long>
+{
+	static unsigned long run(const unsigned int *beg, const unsigned int *end, unsigned long total)
+	{
+		std::size_t n = static_cast<std::size_t>(end - beg);
+		std::size_t i = 0;
+		if (sizeof(unsigned long) == 8) {
+			total += static_cast<unsigned long>(sumInt32To64<false>(beg, n, i));
+		}
+		else {
+			total += sumInt32To32(beg, n, i);
+		}
+
+		for (; i < n; i++) {
+			total += beg[i];
+		}
+		return total;
+	}
+};
+
+// float -> doublecvtps2pd  float תΪ double ӣۼؼӷӳ
+template<>
+struct AccumKernel<float, double>
+{
+	static double run(const float *beg, const float *end, double total)
+	{
+		std::size_t n = static_cast<std::size_t>(end - beg);
+		std::size_t i = 0;
+#ifdef ACCUM_USE_AVX2
+		__m256d a8 = _mm256_setzero_pd();
+		__m256d b8 = _mm256_setzero_pd();
+		for (; i + 8 <= n; i += 8) {
+			a8 = _mm256_add_pd(a8, _mm256_cvtps_pd(_mm_loadu_ps(beg + i)));
+			b8 = _mm256_add_pd(b8, _mm256_cvtps_pd(_mm_loadu_ps(beg + i + 4)));
+		}
+		total += hsumPd(_mm256_add_pd(a8, b8));
+#endif
+		__m128d a = _mm_setzero_pd();
+		__m128d b = _mm_setzero_pd();
+		for (; i + 4 <= n; i += 4) {
+			__m128 v = _mm_loadu_ps(beg + i);
+			a = _mm_add_pd(a, _mm_cvtps_pd(v));
+			b = _mm_add_pd(b, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+		}
+		total += hsumPd(_mm_add_pd(a, b));
+
+		for (; i < n; i++) {
+			total += beg[i];
+		}
+		return total;
+	}
+};
+#endif
+
 // Ϊ˽һ⣬Ϊȡһµģ ATĬֵȡģ:
 template<typename T, typename AT = AccumulateTrait<T>>
 auto accum(T const* beg, T const* end)
+{
+	return AccumKernel<T, typename AT::AccT>::run(beg, end, AT::zero());
+}
+
+// ַʽһûԺԵģЩû ǿָһµȡĬ;
+
+// ң T const* ʽֱӷڴУǾλѹֻ߱䳤롣
+// Ȱ뵽һʱͣҪڴждһ顢һ飻
+// ÿֻ kDecodeBlock ֵջϵСʼ L1 У漴 AccumKernel ͣм顣
+// Ľӿڣvalue_type ǽͣforEachBlock(f) ζÿһ f(value_type *block, std::size_t n)
+// µĽ붼ٶСx86
+constexpr std::size_t kDecodeBlock = 256;
+
+// λѹÿֵռ width1 ~ 32λӵλʼ
+template<typename T>
+class BitPackedInput
+{
+public:
+	using value_type = T;
+
+	BitPackedInput(const std::uint8_t *data_, std::size_t bytes_, std::size_t count_, unsigned width_)
+		: data(data_), bytes(bytes_), count(count_), width(width_)
+	{
+		assert(width >= 1 && width <= 32);
+	}
+
+	template<typename F>
+	void forEachBlock(F f) const
+	{
+		T buf[kDecodeBlock];
+		for (std::size_t i = 0; i < count; i += kDecodeBlock) {
+			std::size_t n = count - i < kDecodeBlock ? count - i : kDecodeBlock;
+			unpack(i, n, buf);
+			f(buf, n);
+		}
+	}
+
+private:
+	// ӵ first ֵʼ n ֵ
+	void unpack(std::size_t first, std::size_t n, T *out) const
+	{
+		const std::uint64_t mask = (std::uint64_t(1) << width) - 1;
+		std::size_t k = 0;
+#ifdef ACCUM_USE_AVX2
+		// width  25 ʱÿֵڴڵֽڿʼ 4 ֽ֮ڣ
+		// һ gather ȡ 8  32 λ֣øԲͬλƣvpsrlvdȡ width λ
+		if (sizeof(T) == 4 && width <= 25) {
+			const __m256i lanes = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(width)));
+			const __m256i vmask = _mm256_set1_epi32(static_cast<int>(mask));
+			for (; k + 8 <= n; k += 8) {
+				std::size_t bit0 = (first + k) * width;
+				if ((bit0 + 8 * width) / 8 + 4 > bytes) {
+					break; // gather ĩβʣµĽѭ
+				}
+
+				__m256i bits = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(bit0 % 8)), lanes);
+				__m256i words = _mm256_i32gather_epi32(reinterpret_cast<const int*>(data + bit0 / 8), _mm256_srli_epi32(bits, 3), 1);
+				__m256i v = _mm256_srlv_epi32(words, _mm256_and_si256(bits, _mm256_set1_epi32(7)));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), _mm256_and_si256(v, vmask));
+			}
+		}
+#endif
+#ifdef ACCUM_USE_SSE2
+		// ֽڶĿȣ8 λ16 λҪλֱӰֽչΪ 32 λ
+		if (sizeof(T) == 4 && width == 8) {
+			for (; k + 16 <= n && first + k + 16 <= bytes; k += 16) {
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + first + k));
+				__m128i lo = _mm_unpacklo_epi8(v, _mm_setzero_si128());
+				__m128i hi = _mm_unpackhi_epi8(v, _mm_setzero_si128());
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + k), _mm_unpacklo_epi16(lo, _mm_setzero_si128()));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + k + 4), _mm_unpackhi_epi16(lo, _mm_setzero_si128()));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + k + 8), _mm_unpacklo_epi16(hi, _mm_setzero_si128()));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + k + 12), _mm_unpackhi_epi16(hi, _mm_setzero_si128()));
+			}
+		}
+		else if (sizeof(T) == 4 && width == 16) {
+			for (; k + 8 <= n && (first + k) * 2 + 16 <= bytes; k += 8) {
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + (first + k) * 2));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + k), _mm_unpacklo_epi16(v, _mm_setzero_si128()));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + k + 4), _mm_unpackhi_epi16(v, _mm_setzero_si128()));
+			}
+		}
+#endif
+		for (; k < n; k++) {
+			std::size_t bit = (first + k) * width;
+			out[k] = static_cast<T>((load64(bit / 8) >> (bit % 8)) & mask);
+		}
+	}
+
+	std::uint64_t load64(std::size_t pos) const
+	{
+		std::uint64_t word = 0;
+		if (pos + 8 <= bytes) {
+			std::memcpy(&word, data + pos, 8);
+		}
+		else {
+			std::memcpy(&word, data + pos, bytes - pos);
+		}
+		return word;
+	}
+
+private:
+	const std::uint8_t *data;
+	std::size_t bytes;
+	std::size_t count;
+	unsigned width;
+};
+
+// zig-zag 䳤varintзӳΪ޷0, -1, 1, -2 ... -> 0, 1, 2, 3 ...
+// ÿ 7 λһţλΪ 1 ʾ滹ֽڡֵС 64 ֻռһֽ
+template<typename T>
+class ZigZagVarintInput
+{
+public:
+	using value_type = T;
+
+	ZigZagVarintInput(const std::uint8_t *data_, std::size_t bytes_) : data(data_), bytes(bytes_)
+	{
+
+	}
+
+	template<typename F>
+	void forEachBlock(F f) const
+	{
+		T buf[kDecodeBlock];
+		const std::uint8_t *p = data;
+		const std::uint8_t *end = data + bytes;
+		while (p != end) {
+			std::size_t n = 0;
+			while (n < kDecodeBlock && p != end) {
+#ifdef ACCUM_USE_SSE2
+				//  16 ֽڶûк־ʱǾ 16 ֽڵֵһν
+				if (sizeof(T) == 4 && n + 16 <= kDecodeBlock && end - p >= 16) {
+					__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+					if (_mm_movemask_epi8(v) == 0) {
+						__m128i lo = _mm_unpacklo_epi8(v, _mm_setzero_si128());
+						__m128i hi = _mm_unpackhi_epi8(v, _mm_setzero_si128());
+						storeZigZag(buf + n, _mm_unpacklo_epi16(lo, _mm_setzero_si128()));
+						storeZigZag(buf + n + 4, _mm_unpackhi_epi16(lo, _mm_setzero_si128()));
+						storeZigZag(buf + n + 8, _mm_unpacklo_epi16(hi, _mm_setzero_si128()));
+						storeZigZag(buf + n + 12, _mm_unpackhi_epi16(hi, _mm_setzero_si128()));
+						p += 16;
+						n += 16;
+						continue;
+					}
+				}
+#endif
+				std::uint64_t u = 0;
+				unsigned shift = 0;
+				std::uint8_t b;
+				do {
+					b = *p++;
+					u |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+					shift += 7;
+				} while ((b & 0x80) && p != end);
+
+				buf[n++] = static_cast<T>(static_cast<std::int64_t>((u >> 1) ^ (0 - (u & 1))));
+			}
+			f(buf, n);
+		}
+	}
+
+private:
+#ifdef ACCUM_USE_SSE2
+	static void storeZigZag(T *out, __m128i u)
+	{
+		__m128i sign = _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(u, _mm_set1_epi32(1)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_xor_si128(_mm_srli_epi32(u, 1), sign));
+	}
+#endif
+
+private:
+	const std::uint8_t *data;
+	std::size_t bytes;
+};
+
+// ǰ׺ͣѲֻԭΪԭʼֵ͵޸ģһֵ
+template<typename T>
+struct PrefixSumKernel
+{
+	static T run(T *p, std::size_t n, T prev)
+	{
+		for (std::size_t i = 0; i < n; i++) {
+			prev += p[i];
+			p[i] = prev;
+		}
+		return prev;
+	}
+};
+
+#ifdef ACCUM_USE_SSE2
+// 32 λĴΡλӡõ 4 Ԫصǰ׺ͣټǰһһֵ޷ƣ
+template<typename T>
+struct PrefixSum32
+{
+	static T run(T *p, std::size_t n, T prev)
+	{
+		std::size_t i = 0;
+		__m128i carry = _mm_set1_epi32(static_cast<int>(prev));
+		for (; i + 4 <= n; i += 4) {
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+			x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+			x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+			x = _mm_add_epi32(x, carry);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p + i), x);
+			carry = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+		}
+
+		std::uint32_t last = static_cast<std::uint32_t>(_mm_cvtsi128_si32(carry));
+		for (; i < n; i++) {
+			last += static_cast<std::uint32_t>(p[i]);
+			p[i] = static_cast<T>(last);
+		}
+		return static_cast<T>(last);
+	}
+};
+
+template<>
+struct PrefixSumKernel<int> : PrefixSum32<int>
+{
+
+};
+
+template<>
+struct PrefixSumKernel<unsigned int> : PrefixSum32<unsigned int>
+{
+
+};
+#endif
+
+// ֣װһֵĲǰ׺ͻԭԭʼֵ
+template<typename Inner>
+class DeltaInput
+{
+public:
+	using value_type = typename Inner::value_type;
+
+	explicit DeltaInput(const Inner &inner_, value_type base_ = value_type()) : inner(inner_), base(base_)
+	{
+
+	}
+
+	template<typename F>
+	void forEachBlock(F f) const
+	{
+		value_type prev = base;
+		inner.forEachBlock([&](value_type *p, std::size_t n) {
+			prev = PrefixSumKernel<value_type>::run(p, n, prev);
+			f(p, n);
+		});
+	}
+
+private:
+	Inner inner;
+	value_type base;
+};
+
+//  accum()ÿһöӦ AccumKernel ӵ total 
+template<typename Input, typename AT = AccumulateTrait<typename Input::value_type>>
+auto accum(const Input &in)
+{
+	using T = typename Input::value_type;
+	typename AT::AccT total = AT::zero();
+
+	in.forEachBlock([&total](T *p, std::size_t n) {
+		total = AccumKernel<T, typename AT::AccT>::run(p, p + n, total);
+	});
+
+	return total;
+}
+
+// ԱãȰ뵽һʱ飬ٶ
+template<typename Input>
+std::vector<typename Input::value_type> decodeAll(const Input &in, std::size_t count)
+{
+	std::vector<typename Input::value_type> out(count);
+	std::size_t pos = 0;
+	in.forEachBlock([&](typename Input::value_type *p, std::size_t n) {
+		std::memcpy(out.data() + pos, p, n * sizeof(*p));
+		pos += n;
+	});
+	return out;
+}
+
+// ɲõı뺯
+inline std::vector<std::uint8_t> packBits(const std::vector<unsigned int> &values, unsigned width)
+{
+	std::vector<std::uint8_t> out((values.size() * width + 7) / 8);
+	for (std::size_t i = 0; i < values.size(); i++) {
+		std::size_t bit = i * width;
+		std::uint64_t v = static_cast<std::uint64_t>(values[i]) << (bit % 8);
+		for (std::size_t j = bit / 8; v != 0; j++, v >>= 8) {
+			out[j] |= static_cast<std::uint8_t>(v & 0xff);
+		}
+	}
+	return out;
+}
+
+inline void putZigZagVarint(std::vector<std::uint8_t> &out, std::int64_t v)
+{
+	std::uint64_t u = (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+	while (u >= 0x80) {
+		out.push_back(static_cast<std::uint8_t>(u | 0x80));
+		u >>= 7;
+	}
+	out.push_back(static_cast<std::uint8_t>(u));
+}
+
+// Աȵӵѭ֮ǰ accum
+template<typename T, typename AT = AccumulateTrait<T>>
+typename AT::AccT scalarAccum(T const* beg, T const* end)
 {
 	typename AT::AccT total = AT::zero();
 
@@ -74,13 +653,111 @@ auto accum(T const* beg, T const* end)
 	return total;
 }
 
-// ַʽһûԺԵģЩû ǿָһµȡĬ;
+//  bytes ֽڵݸɴΣӡѭGB/s
+// ÿһֵһԪأֹÿһֵĽһѭᵽȥ
+//  -100 ~ 100 ֮ҾֵΪ 0256 MB  char  2.7 ڸԪأȫĻ int ۻ
+template<typename T>
+void benchmark(const char *name, std::size_t bytes, int rounds)
+{
+	std::vector<T> data(bytes / sizeof(T));
+	for (std::size_t i = 0; i < data.size(); i++) {
+		data[i] = static_cast<T>(static_cast<int>((i * 2654435761u) % 201) - 100);
+	}
+	const T *beg = data.data();
+	const T *end = beg + data.size() - 3; // һһβ
+
+	double r1 = 0, r2 = 0; // ֽۼƣֻӡ
+
+	// ȸһ飨ʱڵҳӳ
+	r1 += scalarAccum(beg, end);
+	r2 += accum(beg, end);
+
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++) {
+		r1 += scalarAccum(beg + r % 8, end);
+	}
+	std::chrono::duration<double> scalar = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++) {
+		r2 += accum(beg + r % 8, end);
+	}
+	std::chrono::duration<double> simd = std::chrono::steady_clock::now() - start;
+
+	double gb = static_cast<double>(bytes) * rounds / 1e9;
+	std::cout << name << " : scalar " << gb / scalar.count() << " GB/s, kernel " << gb / simd.count()
+			  << " GB/s, results " << r1 << " / " << r2 << std::endl;
+}
+
+template<typename T>
+void benchmark(const char *name)
+{
+	benchmark<T>(name, std::size_t(256) << 20, 8);       // 256 MBڴ
+	benchmark<T>(name, std::size_t(64) << 10, 32768);    // 64 KBݶڻУּ㱾ٶ
+}
 
 int main()
 {
 	int a[3] = { 1, 2, 3 };
 	std::cout << "accum = " << accum(a, a + 3) << std::endl; // OKaccum = 6;
 
+	benchmark<char>("char         -> int          ");
+	benchmark<short>("short        -> int          ");
+	benchmark<int>("int          -> long         ");
+	benchmark<unsigned int>("unsigned int -> unsigned long");
+	benchmark<float>("float        -> double       ");
+
+	// 3200 ֵȰ 12 λѹٰ + zig-zag varint 룻
+	// ֱȽϡȽ뵽ʱ͡롰߽͡
+	const std::size_t count = std::size_t(32) << 20;
+	std::vector<unsigned int> samples(count);
+	std::vector<std::uint8_t> varints;
+	int level = 2000;
+	for (std::size_t i = 0; i < count; i++) {
+		int step = static_cast<int>((i * 2654435761u) >> 29) - 3; // -3 ~ 4 С
+		if (i % 1000 == 0) {
+			step += (i % 3000 == 0) ? 300 : -300; // ż䣬ֽ
+		}
+		level = (level + step) & 0xfff;
+		samples[i] = static_cast<unsigned int>(level);
+	}
+	// 3200  0 ~ 4095 ĲֵܺԼ 6.9e10 Windows  32 λ long
+	// Բֱһ· level - 2048 룬 int  0 Ϊģ
+	// ѹһ· unsigned int Windows Ͻ 2^32 ȡģͷʽĽȻһ
+	int prevSample = 0;
+	for (std::size_t i = 0; i < count; i++) {
+		int centered = static_cast<int>(samples[i]) - 2048;
+		putZigZagVarint(varints, centered - prevSample);
+		prevSample = centered;
+	}
+	std::vector<std::uint8_t> packed = packBits(samples, 12);
+
+	BitPackedInput<unsigned int> bitInput(packed.data(), packed.size(), count, 12);
+	DeltaInput<ZigZagVarintInput<int>> deltaInput(ZigZagVarintInput<int>(varints.data(), varints.size()));
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<unsigned int> decoded = decodeAll(bitInput, count);
+	unsigned long bitTwoPass = accum(decoded.data(), decoded.data() + decoded.size());
+	std::chrono::duration<double, std::milli> bitTwoPassMs = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	unsigned long bitFused = accum(bitInput);
+	std::chrono::duration<double, std::milli> bitFusedMs = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	std::vector<int> values = decodeAll(deltaInput, count);
+	long deltaTwoPass = accum(values.data(), values.data() + values.size());
+	std::chrono::duration<double, std::milli> deltaTwoPassMs = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	long deltaFused = accum(deltaInput);
+	std::chrono::duration<double, std::milli> deltaFusedMs = std::chrono::steady_clock::now() - start;
+
+	std::cout << "12-bit packed (" << packed.size() / (1 << 20) << " MB), decode then accum : " << bitTwoPassMs.count() << " ms, sum = " << bitTwoPass << std::endl;
+	std::cout << "12-bit packed (" << packed.size() / (1 << 20) << " MB), fused             : " << bitFusedMs.count() << " ms, sum = " << bitFused << std::endl;
+	std::cout << "delta + varint (" << varints.size() / (1 << 20) << " MB), decode then accum : " << deltaTwoPassMs.count() << " ms, sum = " << deltaTwoPass << std::endl;
+	std::cout << "delta + varint (" << varints.size() / (1 << 20) << " MB), fused             : " << deltaFusedMs.count() << " ms, sum = " << deltaFused << std::endl;
+
 	return 0;
 
 }
@@ -1,4 +1,24 @@
 #include <iostream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <unordered_map>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ACCUM_USE_SSE2 1
+#include <emmintrin.h>
+#endif
 
 // ĿǰΪֹǲûۻaccumulationͣsummationҲۻ
 // 磬ǿԶһֵ˵ЩֵַĻ ǿԽ
@@ -60,13 +80,193 @@ struct AccumulateTrait<float>
 	}
 };
 
+// SumPolicy Ķ棬ĬģʵֻҪһ֣ʵ accum ʱѾ
+class SumPolicy;
+
+// Щԣ KahanSumPolicyPairwiseSumPolicyҪԣ
+// ʱṩһ accumulate_range(total, beg, end)Ԫص accumulate(total, value)
+//  SFINAE Ƿ accumulate_rangeеĻһظƥ䣨0  intûеĻֻʣµڶ
+template<typename Policy, typename AccT, typename T>
+auto accumulateRange(AccT &total, T const* beg, T const* end, int) -> decltype(Policy::accumulate_range(total, beg, end), void())
+{
+	Policy::accumulate_range(total, beg, end);
+}
+
+template<typename Policy, typename AccT, typename T>
+void accumulateRange(AccT &total, T const* beg, T const* end, long)
+{
+	while (beg != end) {
+		Policy::accumulate(total, *beg);
+		++beg;
+	}
+}
+
+// ʼֵʹ 0 ʼȴҪ 1 ʼԳʼֵӦɲԾȡ
+// ṩ identity<AccT>() ʱۻĵλԪ˻صȡ zero()
+template<typename Policy, typename Traits>
+auto initialValue(int) -> decltype(Policy::template identity<typename Traits::AccT>())
+{
+	return Policy::template identity<typename Traits::AccT>();
+}
+
+template<typename Policy, typename Traits>
+typename Traits::AccT initialValue(long)
+{
+	return Traits::zero();
+}
+
+// ϲ̸ֽ߳Ե totalԵĺϲǰѲֽһֵ accumulate 
+//  CountPolicy  accumulate ǡ 1ϲȴҪӡĲṩ combine(total, partial)
+// ͬ SFINAE ⣬ûеĻ˻ص accumulate
+template<typename Policy, typename AccT>
+auto combineResults(AccT &total, AccT const& partial, int) -> decltype(Policy::combine(total, partial), void())
+{
+	Policy::combine(total, partial);
+}
+
+template<typename Policy, typename AccT>
+void combineResults(AccT &total, AccT const& partial, long)
+{
+	Policy::accumulate(total, partial);
+}
+
 template<typename T, typename Policy = SumPolicy, typename Traits = AccumulateTrait<T>>
 auto accum(T const* beg, T const* end) {
 	using AccT = typename Traits::AccT;
-	AccT total = Traits::zero(); 
-	while (beg != end) { 
-		Policy::accumulate(total, *beg); 
-		++beg;
+	AccT total = initialValue<Policy, Traits>(0); 
+	accumulateRange<Policy>(total, beg, end, 0);
+	return total;
+}
+
+// һ򵥵Ĺ̶С̳߳أrun(f) óеỵ̈߳ԼΪ 0ִһ f(̱߳)
+// ̶ִ֮߳ŷء߳ run ֮ϣᷴ
+class ThreadPool
+{
+public:
+	explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency()) : generation(0), pending(0), stop(false)
+	{
+		if (threads == 0) {
+			threads = 1;
+		}
+		for (std::size_t i = 1; i < threads; i++) {
+			workers.emplace_back([this, i]() { workerLoop(i); });
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m);
+			stop = true;
+		}
+		cv.notify_all();
+		for (auto &it : workers) {
+			it.join();
+		}
+	}
+
+	std::size_t size() const
+	{
+		return workers.size() + 1;
+	}
+
+	template<typename F>
+	void run(F f)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m);
+			job = f;
+			generation++;
+			pending = workers.size();
+		}
+		cv.notify_all();
+
+		f(0);
+
+		std::unique_lock<std::mutex> lock(m);
+		doneCv.wait(lock, [this]() { return pending == 0; });
+	}
+
+private:
+	void workerLoop(std::size_t index)
+	{
+		std::size_t seen = 0;
+		for (;;) {
+			std::function<void(std::size_t)> current;
+			{
+				std::unique_lock<std::mutex> lock(m);
+				cv.wait(lock, [&]() { return stop || generation != seen; });
+				if (stop) {
+					return;
+				}
+				seen = generation;
+				current = job;
+			}
+
+			current(index);
+
+			std::lock_guard<std::mutex> lock(m);
+			if (--pending == 0) {
+				doneCv.notify_one();
+			}
+		}
+	}
+
+private:
+	std::vector<std::thread> workers;
+	std::mutex m;
+	std::condition_variable cv;
+	std::condition_variable doneCv;
+	std::function<void(std::size_t)> job;
+	std::size_t generation;
+	std::size_t pending;
+	bool stop;
+};
+
+// ÿ̸߳ԵĲֽvalue һе䣬
+// ￪ʼ̵߳ value ͬһϣα
+static constexpr std::size_t kCacheLine = 64;
+
+template<typename T>
+struct CachePadded
+{
+	T value;
+	char pad[kCacheLine];
+};
+
+// Ĭÿһ 256 KBһĵ L2 С
+static constexpr std::size_t kDefaultChunkBytes = 256 * 1024;
+
+// ̰߳汾 accum()г chunkSize Ԫһ飬 t ߳δ tt + Nt + 2N ... 飻
+// ÿ߳ھֲۻдԼ CachePadded ֽɵ̱߰߳ŵ˳ combineResultsPolicy  combineûеĻ accumulateϲ
+// ֿ鷽ʽ̵ִ߳п޹أͬ롢ͬ߳ÿεĽȫһԸҲˣ
+template<typename T, typename Policy = SumPolicy, typename Traits = AccumulateTrait<T>>
+auto accum(ThreadPool &pool, T const* beg, T const* end, std::size_t chunkSize = kDefaultChunkBytes / sizeof(T)) {
+	using AccT = typename Traits::AccT;
+	if (chunkSize == 0) {
+		chunkSize = 1; // ʱ
+	}
+	const std::size_t n = static_cast<std::size_t>(end - beg);
+	const std::size_t chunks = (n + chunkSize - 1) / chunkSize;
+	const std::size_t threads = pool.size();
+	std::vector<CachePadded<AccT>> partials(threads);
+
+	pool.run([&](std::size_t t) {
+		AccT total = initialValue<Policy, Traits>(0);
+		for (std::size_t c = t; c < chunks; c += threads) {
+			T const* p = beg + c * chunkSize;
+			T const* last = c + 1 < chunks ? p + chunkSize : end;
+			accumulateRange<Policy>(total, p, last, 0);
+		}
+		partials[t].value = total;
+	});
+
+	AccT total = partials[0].value;
+	for (std::size_t t = 1; t < threads; t++) {
+		combineResults<Policy>(total, partials[t].value, 0);
 	}
 	return total;
 }
@@ -75,6 +275,11 @@ auto accum(T const* beg, T const* end) {
 // SumPolicy Աʵֳ
 class SumPolicy {
 public: 
+	template<typename T1>
+	static constexpr T1 identity() {
+		return 0;
+	}
+
 	template<typename T1, typename T2> 
 	static void accumulate(T1& total, T2 const& value) { 
 		total += value; 
@@ -86,12 +291,569 @@ public:
 class MultPolicy
 { 
 public:
+	template<typename T1>
+	static constexpr T1 identity() {
+		return 1;
+	}
+
 	template<typename T1, typename T2>
 	static void accumulate(T1& total, T2 const& value) {
 		total *= value; 
 	}
 };
 
+// Сֵֵͼͬдۻ
+class MinPolicy
+{
+public:
+	template<typename T1>
+	static constexpr T1 identity() {
+		return std::numeric_limits<T1>::max();
+	}
+
+	template<typename T1, typename T2>
+	static void accumulate(T1& total, T2 const& value) {
+		if (value < total) {
+			total = value;
+		}
+	}
+};
+
+class MaxPolicy
+{
+public:
+	template<typename T1>
+	static constexpr T1 identity() {
+		return std::numeric_limits<T1>::lowest();
+	}
+
+	template<typename T1, typename T2>
+	static void accumulate(T1& total, T2 const& value) {
+		if (total < value) {
+			total = value;
+		}
+	}
+};
+
+class CountPolicy
+{
+public:
+	template<typename T1>
+	static constexpr T1 identity() {
+		return 0;
+	}
+
+	template<typename T1, typename T2>
+	static void accumulate(T1& total, T2 const&) {
+		++total;
+	}
+
+	// ּӣһ
+	template<typename T1>
+	static void combine(T1& total, T1 const& partial) {
+		total += partial;
+	}
+};
+
+// ͬһҪͬʱ͡СֵֵʱĴ accum() Ҫڴжı顣
+// accum_many<SumPolicy, MultPolicy, MinPolicy, MaxPolicy>(beg, end) ֻһ飬ÿһԪؾͽеĲԣ
+// һ std::tupleԵ˳ŸԵĽ
+template<typename Policy, typename AccT>
+using AccFor = AccT; // ÿԸӦһ AccT
+
+template<typename... Policies, typename Tuple, typename T, std::size_t... I>
+void accumManyImpl(Tuple &totals, T const* beg, T const* end, std::index_sequence<I...>)
+{
+	while (beg != end) {
+		// C++14 û۵ʽĳʼб˳չ
+		int expand[] = { (Policies::accumulate(std::get<I>(totals), *beg), 0)... };
+		(void)expand;
+		++beg;
+	}
+}
+
+template<typename... Policies, typename T, typename Traits = AccumulateTrait<T>>
+auto accum_many(T const* beg, T const* end)
+{
+	using AccT = typename Traits::AccT;
+	std::tuple<AccFor<Policies, AccT>...> totals(initialValue<Policies, Traits>(0)...);
+	accumManyImpl<Policies...>(totals, beg, end, std::index_sequence_for<Policies...>());
+	return totals;
+}
+
+// ۻǡ͡ÿͬļֵۻ
+// GroupTable һѰַ̽⣩ĹϣÿλѼۻһ
+// һֻͨһУװӲ 1/2ʱ
+// һγʱۻ initialValue ʼ֮󽻸 Policy::accumulate accum() ȫһ
+template<typename K, typename AccT, typename Policy>
+class GroupTable
+{
+	static_assert(std::is_integral<K>::value, "GroupTable<K> requires an integral key");
+
+	struct Slot
+	{
+		K key;
+		bool used;
+		AccT total;
+	};
+
+public:
+	explicit GroupTable(AccT init_ = AccT(), std::size_t expected = 0) : init(init_), count(0)
+	{
+		std::size_t capacity = 16;
+		while (capacity < expected * 2) {
+			capacity *= 2;
+		}
+		allocate(capacity);
+	}
+
+	// Ӧۻһγʱ init ʼ
+	AccT& operator[](K key)
+	{
+		std::size_t i = indexOf(key);
+		while (slots[i].used) {
+			if (slots[i].key == key) {
+				return slots[i].total;
+			}
+			i = (i + 1) & mask;
+		}
+
+		if ((count + 1) * 2 > slots.size()) {
+			grow();
+			return (*this)[key];
+		}
+
+		Slot &s = slots[i];
+		s.used = true;
+		s.key = key;
+		s.total = init;
+		count++;
+		return s.total;
+	}
+
+	template<typename T>
+	void accumulate(K key, T const& value)
+	{
+		Policy::accumulate((*this)[key], value);
+	}
+
+	// ûʱ nullptr
+	const AccT* find(K key) const
+	{
+		for (std::size_t i = indexOf(key); slots[i].used; i = (i + 1) & mask) {
+			if (slots[i].key == key) {
+				return &slots[i].total;
+			}
+		}
+		return nullptr;
+	}
+
+	std::size_t size() const
+	{
+		return count;
+	}
+
+	// ζÿһ f(, ۻ)˳ĴС޹
+	template<typename F>
+	void for_each(F f) const
+	{
+		for (const auto &it : slots) {
+			if (it.used) {
+				f(it.key, it.total);
+			}
+		}
+	}
+
+	// ϲһһ̵߳ľֲͬһֽ combineResults ϲ
+	void merge(const GroupTable &rhs)
+	{
+		rhs.for_each([this](K key, AccT const& total) {
+			combineResults<Policy>((*this)[key], total, 0);
+		});
+	}
+
+private:
+	// Fibonacci ɢУ 2^64 / ƽָȣȡλļҲᱻȵشɢ
+	std::size_t indexOf(K key) const
+	{
+		return static_cast<std::size_t>((static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ull) >> shift);
+	}
+
+	void allocate(std::size_t capacity)
+	{
+		slots.assign(capacity, Slot());
+		mask = capacity - 1;
+		shift = 64;
+		for (std::size_t c = capacity; c > 1; c /= 2) {
+			shift--;
+		}
+	}
+
+	void grow()
+	{
+		std::vector<Slot> old = std::move(slots);
+		allocate(old.size() * 2);
+		for (const auto &it : old) {
+			if (it.used) {
+				std::size_t i = indexOf(it.key);
+				while (slots[i].used) {
+					i = (i + 1) & mask;
+				}
+				slots[i] = it;
+			}
+		}
+	}
+
+private:
+	std::vector<Slot> slots;
+	AccT init;
+	std::size_t count;
+	std::size_t mask;
+	unsigned shift;
+};
+
+// ȡֵΧС缸ٸŵţʱϣʡֱ  - С Ϊ±ꡣ
+// 鲻 kDenseMaxKeys Ԫأ64K ܷ L2 УҲԪظ
+static constexpr std::size_t kDenseMaxKeys = std::size_t(1) << 16;
+
+template<typename K>
+struct KeyRange
+{
+	K lo;
+	K hi;
+};
+
+template<typename K>
+KeyRange<K> keyRange(K const* keys, std::size_t n)
+{
+	KeyRange<K> r = { keys[0], keys[0] };
+	for (std::size_t i = 1; i < n; i++) {
+		if (keys[i] < r.lo) {
+			r.lo = keys[i];
+		}
+		if (r.hi < keys[i]) {
+			r.hi = keys[i];
+		}
+	}
+	return r;
+}
+
+// ± =  - lo޷㣬зŵļҲ
+template<typename K>
+std::size_t denseIndex(K key, K lo)
+{
+	return static_cast<std::size_t>(static_cast<std::uint64_t>(key) - static_cast<std::uint64_t>(lo));
+}
+
+template<typename K>
+bool useDense(const KeyRange<K> &r, std::size_t n)
+{
+	std::size_t range = denseIndex(r.hi, r.lo);
+	return range < kDenseMaxKeys && range < n;
+}
+
+template<typename Policy, typename K, typename T, typename AccT>
+void accumulateDense(AccT *totals, unsigned char *seen, K lo, K const* keys, T const* values, std::size_t n)
+{
+	for (std::size_t i = 0; i < n; i++) {
+		std::size_t k = denseIndex(keys[i], lo);
+		Policy::accumulate(totals[k], values[i]);
+		seen[k] = 1;
+	}
+}
+
+template<typename Policy, typename K, typename AccT>
+void denseToTable(GroupTable<K, AccT, Policy> &table, const AccT *totals, const unsigned char *seen, K lo, std::size_t range)
+{
+	for (std::size_t k = 0; k < range; k++) {
+		if (seen[k]) {
+			table[static_cast<K>(static_cast<std::uint64_t>(lo) + k)] = totals[k];
+		}
+	}
+}
+
+// group_accum<Policy>(keys, values, n)ÿͬ keys[i] Policy ۻӦ values[i]һ GroupTable
+template<typename Policy = SumPolicy, typename K, typename T, typename Traits = AccumulateTrait<T>>
+GroupTable<K, typename Traits::AccT, Policy> group_accum(K const* keys, T const* values, std::size_t n)
+{
+	using AccT = typename Traits::AccT;
+	const AccT init = initialValue<Policy, Traits>(0);
+	GroupTable<K, AccT, Policy> table(init);
+	if (n == 0) {
+		return table;
+	}
+
+	KeyRange<K> r = keyRange(keys, n);
+	if (useDense(r, n)) {
+		const std::size_t range = denseIndex(r.hi, r.lo) + 1;
+		std::vector<AccT> totals(range, init);
+		std::vector<unsigned char> seen(range);
+		accumulateDense<Policy>(totals.data(), seen.data(), r.lo, keys, values, n);
+		denseToTable(table, totals.data(), seen.data(), r.lo, range);
+		return table;
+	}
+
+	for (std::size_t i = 0; i < n; i++) {
+		table.accumulate(keys[i], values[i]);
+	}
+	return table;
+}
+
+// ̰߳汾ֿ鷽ʽ̵߳ accum() ͬÿ߳Լľֲ߾ֲ飩ۻ
+// ɵ̱߰߳ŵ˳ϲ̵ִ߳п޹
+template<typename Policy = SumPolicy, typename K, typename T, typename Traits = AccumulateTrait<T>>
+GroupTable<K, typename Traits::AccT, Policy> group_accum(ThreadPool &pool, K const* keys, T const* values, std::size_t n,
+														  std::size_t chunkSize = kDefaultChunkBytes / sizeof(T))
+{
+	using AccT = typename Traits::AccT;
+	if (chunkSize == 0) {
+		chunkSize = 1; // ʱ
+	}
+	const AccT init = initialValue<Policy, Traits>(0);
+	const std::size_t chunks = (n + chunkSize - 1) / chunkSize;
+	const std::size_t threads = pool.size();
+	GroupTable<K, AccT, Policy> table(init);
+	if (n == 0) {
+		return table;
+	}
+
+	// һ飺߳ԼЩмķΧǷʹ
+	std::vector<CachePadded<KeyRange<K>>> ranges(threads);
+	pool.run([&](std::size_t t) {
+		KeyRange<K> r = { keys[0], keys[0] };
+		for (std::size_t c = t; c < chunks; c += threads) {
+			std::size_t first = c * chunkSize;
+			KeyRange<K> part = keyRange(keys + first, std::min(chunkSize, n - first));
+			r.lo = std::min(r.lo, part.lo);
+			r.hi = std::max(r.hi, part.hi);
+		}
+		ranges[t].value = r;
+	});
+
+	KeyRange<K> r = ranges[0].value;
+	for (std::size_t t = 1; t < threads; t++) {
+		r.lo = std::min(r.lo, ranges[t].value.lo);
+		r.hi = std::max(r.hi, ranges[t].value.hi);
+	}
+
+	if (useDense(r, n)) {
+		const std::size_t range = denseIndex(r.hi, r.lo) + 1;
+		std::vector<std::vector<AccT>> totals(threads);
+		std::vector<std::vector<unsigned char>> seen(threads);
+		pool.run([&](std::size_t t) {
+			// ڸԵ߳зֲ飬Ž totals[t]seen[t]ۻ֮߳䲻κλ
+			std::vector<AccT> localTotals(range, init);
+			std::vector<unsigned char> localSeen(range);
+			for (std::size_t c = t; c < chunks; c += threads) {
+				std::size_t first = c * chunkSize;
+				accumulateDense<Policy>(localTotals.data(), localSeen.data(), r.lo, keys + first, values + first, std::min(chunkSize, n - first));
+			}
+			totals[t] = std::move(localTotals);
+			seen[t] = std::move(localSeen);
+		});
+
+		for (std::size_t t = 1; t < threads; t++) {
+			for (std::size_t k = 0; k < range; k++) {
+				if (seen[t][k]) {
+					combineResults<Policy>(totals[0][k], totals[t][k], 0);
+					seen[0][k] = 1;
+				}
+			}
+		}
+		denseToTable(table, totals[0].data(), seen[0].data(), r.lo, range);
+		return table;
+	}
+
+	std::vector<GroupTable<K, AccT, Policy>> tables(threads, GroupTable<K, AccT, Policy>(init));
+	pool.run([&](std::size_t t) {
+		GroupTable<K, AccT, Policy> local(init);
+		for (std::size_t c = t; c < chunks; c += threads) {
+			std::size_t first = c * chunkSize;
+			std::size_t last = std::min(first + chunkSize, n);
+			for (std::size_t i = first; i < last; i++) {
+				local.accumulate(keys[i], values[i]);
+			}
+		}
+		tables[t] = std::move(local);
+	});
+
+	table = std::move(tables[0]);
+	for (std::size_t t = 1; t < threads; t++) {
+		table.merge(tables[t]);
+	}
+	return table;
+}
+
+//  float ʱtotal ԽԽÿμһСᶪĵλ10^8 Ԫ֮Ѿǳԣ
+// AccumulateTrait<float>  AccT չΪ double Ի⣬ SIMD Ĵ double ĸֻ float һ롣
+//  AccT Ϊ float FloatAccumulateTraitñİ취
+// ע⣺ڸϸմ˳ִУʹ -ffast-math  /fp:fast 롣
+struct FloatAccumulateTrait
+{
+	using AccT = float;
+
+	static constexpr AccT zero()
+	{
+		return 0;
+	}
+};
+
+// Kahan ͣ c סÿʱĵλһ֮ǰȥԪظ޹ء
+//  (sum, c) ܳͬʱά 8  float ͨ SSE Ĵٺϲ
+class KahanSumPolicy
+{
+public:
+	template<typename T1>
+	static constexpr T1 identity() {
+		return 0;
+	}
+
+	//  c ֻ accumulate_range ڲԪص accumulate ޷ֻ˻Ϊͨ͡
+	// Ϊ˲ĵضȣԪۻ÷accum_manyGroupTable ȣֱӱʧ
+	template<typename T1, typename T2>
+	static void accumulate(T1&, T2 const&) {
+		static_assert(sizeof(T2) == 0, "KahanSumPolicy only supports whole ranges (accumulate_range)");
+	}
+
+	// ϲ̵߳Ĳֻֽ߳ôμӷֱ
+	template<typename T1>
+	static void combine(T1& total, T1 const& partial) {
+		total += partial;
+	}
+
+	template<typename T1, typename T2>
+	static void accumulate_range(T1& total, T2 const* beg, T2 const* end) {
+		T1 c = 0;
+		while (beg != end) {
+			add(total, c, static_cast<T1>(*beg));
+			++beg;
+		}
+		total -= c;
+	}
+
+#ifdef ACCUM_USE_SSE2
+	static void accumulate_range(float& total, float const* beg, float const* end) {
+		std::size_t n = static_cast<std::size_t>(end - beg);
+		std::size_t i = 0;
+		__m128 sum0 = _mm_setzero_ps(), c0 = _mm_setzero_ps();
+		__m128 sum1 = _mm_setzero_ps(), c1 = _mm_setzero_ps();
+		for (; i + 8 <= n; i += 8) {
+			step(sum0, c0, _mm_loadu_ps(beg + i));
+			step(sum1, c1, _mm_loadu_ps(beg + i + 4));
+		}
+
+		// ͨĺ벹ñ Kahan ӵ total ϣȻǲ 8 β
+		alignas(16) float sums[8];
+		alignas(16) float comps[8];
+		_mm_store_ps(sums, sum0);
+		_mm_store_ps(sums + 4, sum1);
+		_mm_store_ps(comps, c0);
+		_mm_store_ps(comps + 4, c1);
+
+		float c = 0;
+		for (int k = 0; k < 8; k++) {
+			add(total, c, sums[k]);
+			add(total, c, -comps[k]);
+		}
+		for (; i < n; i++) {
+			add(total, c, beg[i]);
+		}
+		total -= c;
+	}
+#endif
+
+private:
+	template<typename T1>
+	static void add(T1& sum, T1& c, T1 value) {
+		T1 y = value - c;
+		T1 t = sum + y;
+		c = (t - sum) - y; // (t - sum) ȥĲ֣ȥ y ǱĲ
+		sum = t;
+	}
+
+#ifdef ACCUM_USE_SSE2
+	static void step(__m128& sum, __m128& c, __m128 value) {
+		__m128 y = _mm_sub_ps(value, c);
+		__m128 t = _mm_add_ps(sum, y);
+		c = _mm_sub_ps(_mm_sub_ps(t, sum), y);
+		sum = t;
+	}
+#endif
+};
+
+// ͣpairwise summation԰ֱֿ֮ӣֻ log(n) 
+// ݹ鵽 kBlock Ԫʱֱͣһ 8  float ͨûж㣬ٶͨͬ
+class PairwiseSumPolicy
+{
+	static constexpr std::size_t kBlock = 256;
+
+public:
+	template<typename T1>
+	static constexpr T1 identity() {
+		return 0;
+	}
+
+	template<typename T1, typename T2>
+	static void accumulate(T1& total, T2 const& value) {
+		total += value;
+	}
+
+	template<typename T1, typename T2>
+	static void accumulate_range(T1& total, T2 const* beg, T2 const* end) {
+		total += pairwise<T1>(beg, static_cast<std::size_t>(end - beg));
+	}
+
+private:
+	template<typename T1, typename T2>
+	static T1 pairwise(T2 const* beg, std::size_t n) {
+		if (n <= kBlock) {
+			return block<T1>(beg, n);
+		}
+
+		std::size_t half = (n / kBlock + 1) / 2 * kBlock; // ֽ kBlock 
+		return pairwise<T1>(beg, half) + pairwise<T1>(beg + half, n - half);
+	}
+
+	template<typename T1, typename T2>
+	static T1 block(T2 const* beg, std::size_t n) {
+		T1 lanes[8] = {};
+		const std::size_t full = n / 8 * 8;
+		std::size_t i = 0;
+		for (; i < full; i += 8) {
+			for (int k = 0; k < 8; k++) {
+				lanes[k] += static_cast<T1>(beg[i + k]);
+			}
+		}
+		T1 sum = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+		for (; i < n; i++) {
+			sum += static_cast<T1>(beg[i]);
+		}
+		return sum;
+	}
+};
+
+#ifdef ACCUM_USE_SSE2
+template<>
+inline float PairwiseSumPolicy::block<float, float>(float const* beg, std::size_t n) {
+	__m128 a = _mm_setzero_ps();
+	__m128 b = _mm_setzero_ps();
+	const std::size_t full = n / 8 * 8;
+	std::size_t i = 0;
+	for (; i < full; i += 8) {
+		a = _mm_add_ps(a, _mm_loadu_ps(beg + i));
+		b = _mm_add_ps(b, _mm_loadu_ps(beg + i + 4));
+	}
+
+	alignas(16) float lanes[4];
+	_mm_store_ps(lanes, _mm_add_ps(a, b));
+	float sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+	for (; i < n; i++) {
+		sum += beg[i];
+	}
+	return sum;
+}
+#endif
+
 // ҪһڶԲһʵʹƣӦһЩĳ ģ¶Ϊࣻ
 // Ժȡкֻ֮ܶǸΪ͡
 // Ҫ ȡࣺһģࡣΪһ࣬õͺͳ
@@ -103,10 +865,152 @@ int main()
 	int num[] = { 1, 2, 3, 4, 5 }; 
 	// print product of all values 
 	std::cout << "the product of the integer values is " << accum<int,MultPolicy>(num, num+5) << std::endl; 
-	// ӡǣthe product of the integer values is 0
+	// ʼֵȡ zero()ӡǣthe product of the integer values is 0
 	// ǲԵġǶԳʼֵѡȡȻ 0 ܺܺõ͵󣬵ȴ˻ʼֵ 0 ó˻ĽҲ 0
-	// ˵ͬȡͲԿܻ໥Ӱ졣
+	// ˵ͬȡͲԿܻ໥Ӱ졣ڳʼֵɲԵ identity() ṩMultPolicy  1 ʼӡ 120
+
+	auto stats = accum_many<SumPolicy, MultPolicy, MinPolicy, MaxPolicy, CountPolicy>(num, num + 5);
+	std::cout << "sum = " << std::get<0>(stats) << ", product = " << std::get<1>(stats) << ", min = " << std::get<2>(stats)
+			  << ", max = " << std::get<3>(stats) << ", count = " << std::get<4>(stats) << std::endl;
+
+	// ߳͵չԣ1 GB  int2  6 ǧ߳ 1 ӵӲ߳
+	//  -500 ~ 500 ֮ѭܺͽӽ 0Windows  AccumulateTrait<int>::AccTlongֻ 32 λ
+	std::vector<int> data((std::size_t(1) << 30) / sizeof(int));
+	for (std::size_t i = 0; i < data.size(); i++) {
+		data[i] = static_cast<int>(i % 1001) - 500;
+	}
+
+	std::size_t maxThreads = std::thread::hardware_concurrency();
+	if (maxThreads == 0) {
+		maxThreads = 1;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	long serial = accum(data.data(), data.data() + data.size());
+	std::chrono::duration<double, std::milli> serialMs = std::chrono::steady_clock::now() - start;
+	std::cout << "serial    : " << serialMs.count() << " ms, sum = " << serial << std::endl;
+
+	std::vector<std::size_t> counts; // 1, 2, 4, ... ԼӲ߳
+	for (std::size_t threads = 1; threads < maxThreads; threads *= 2) {
+		counts.push_back(threads);
+	}
+	counts.push_back(maxThreads);
+
+	for (std::size_t threads : counts) {
+		ThreadPool pool(threads);
+		start = std::chrono::steady_clock::now();
+		long sum = accum(pool, data.data(), data.data() + data.size());
+		std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - start;
+		std::cout << threads << " threads : " << ms.count() << " ms, " << (std::size_t(1) << 30) / ms.count() / 1e6 << " GB/s, sum = " << sum << std::endl;
+	}
+
+	// ֽ combine ϲ̵߳ļ뵥̵߳ͬ
+	{
+		ThreadPool pool(4);
+		std::cout << "count : serial " << accum<int, CountPolicy>(data.data(), data.data() + data.size())
+				  << ", 4 threads " << accum<int, CountPolicy>(pool, data.data(), data.data() + data.size()) << std::endl;
+	}
 
+	// 1  3 ǧ [0, 1) ֮ float512 MB
+	// οֵ AccT = double  Kahan ͣAccumulateTrait<float>  KahanSumPolicy ͨð汾
+	std::vector<float> values(std::size_t(1) << 27);
+	for (std::size_t i = 0; i < values.size(); i++) {
+		values[i] = static_cast<float>((i * 2654435761u) % 1000003) / 1000003.0f;
+	}
+	const float *vb = values.data();
+	const float *ve = vb + values.size();
+	const double exact = accum<float, KahanSumPolicy>(vb, ve);
+
+	auto report = [&](const char *name, double (*f)(const float*, const float*)) {
+		auto t0 = std::chrono::steady_clock::now();
+		double result = f(vb, ve);
+		std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - t0;
+		std::cout << name << " : " << ms.count() << " ms, " << values.size() * sizeof(float) / ms.count() / 1e6
+				  << " GB/s, relative error " << std::fabs(result - exact) / exact << std::endl;
+	};
+
+	report("SumPolicy         AccT = double", [](const float *b, const float *e) -> double { return accum(b, e); });
+	report("SumPolicy         AccT = float ", [](const float *b, const float *e) -> double { return accum<float, SumPolicy, FloatAccumulateTrait>(b, e); });
+	report("KahanSumPolicy    AccT = float ", [](const float *b, const float *e) -> double { return accum<float, KahanSumPolicy, FloatAccumulateTrait>(b, e); });
+	report("PairwiseSumPolicy AccT = float ", [](const float *b, const float *e) -> double { return accum<float, PairwiseSumPolicy, FloatAccumulateTrait>(b, e); });
+
+	// ͡СֵֵĴ accum() ı 512 MBaccum_many() ֻһ
+	start = std::chrono::steady_clock::now();
+	double sum4 = accum<float, SumPolicy>(vb, ve);
+	double product4 = accum<float, MultPolicy>(vb, ve);
+	double min4 = accum<float, MinPolicy>(vb, ve);
+	double max4 = accum<float, MaxPolicy>(vb, ve);
+	std::chrono::duration<double, std::milli> separateMs = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	auto fused = accum_many<SumPolicy, MultPolicy, MinPolicy, MaxPolicy>(vb, ve);
+	std::chrono::duration<double, std::milli> fusedMs = std::chrono::steady_clock::now() - start;
+
+	const double mb = static_cast<double>(values.size() * sizeof(float)) / (1 << 20);
+	std::cout << "4 x accum()  : " << separateMs.count() << " ms, " << 4 * mb << " MB read, sum = " << sum4 << ", product = " << product4
+			  << ", min = " << min4 << ", max = " << max4 << std::endl;
+	std::cout << "accum_many() : " << fusedMs.count() << " ms, " << mb << " MB read, sum = " << std::get<0>(fused) << ", product = " << std::get<1>(fused)
+			  << ", min = " << std::get<2>(fused) << ", max = " << std::get<3>(fused) << std::endl;
+
+	// ͣ1600 ¼ֱ 1000 ļ飩 100 ɢļ߹ϣ
+	//  std::unordered_map Ƚ
+	const std::size_t records = std::size_t(16) << 20;
+	std::vector<int> groupValues(records);
+	std::vector<int> denseKeys(records);
+	std::vector<unsigned int> sparseKeys(records);
+	for (std::size_t i = 0; i < records; i++) {
+		std::size_t h = (i * 2654435761u) >> 7;
+		groupValues[i] = static_cast<int>(i % 100);
+		denseKeys[i] = static_cast<int>(h % 1000);
+		sparseKeys[i] = static_cast<unsigned int>((h % 1000000) * 2654435761u); // 100 ɢ 32 λΧ
+	}
+
+	auto groupBenchmark = [&](const char *name, auto const* keys) {
+		using K = std::remove_const_t<std::remove_reference_t<decltype(*keys)>>;
+
+		auto t0 = std::chrono::steady_clock::now();
+		std::unordered_map<K, long> map;
+		for (std::size_t i = 0; i < records; i++) {
+			map[keys[i]] += groupValues[i];
+		}
+		std::chrono::duration<double, std::milli> mapMs = std::chrono::steady_clock::now() - t0;
+
+		t0 = std::chrono::steady_clock::now();
+		auto table = group_accum(keys, groupValues.data(), records);
+		std::chrono::duration<double, std::milli> tableMs = std::chrono::steady_clock::now() - t0;
+
+		ThreadPool pool;
+		t0 = std::chrono::steady_clock::now();
+		auto parallel = group_accum(pool, keys, groupValues.data(), records);
+		std::chrono::duration<double, std::milli> parallelMs = std::chrono::steady_clock::now() - t0;
+
+		bool same = map.size() == table.size() && table.size() == parallel.size();
+		table.for_each([&](K key, long total) {
+			same = same && map[key] == total && *parallel.find(key) == total;
+		});
+		std::cout << name << " : unordered_map " << mapMs.count() << " ms, group_accum " << tableMs.count() << " ms, group_accum("
+				  << pool.size() << " threads) " << parallelMs.count() << " ms, " << table.size() << " groups, " << (same ? "same" : "DIFFERENT") << std::endl;
+	};
+	groupBenchmark("1000 dense keys   ", denseKeys.data());
+	groupBenchmark("1000000 sparse keys", sparseKeys.data());
+
+	// ͵Ĳԣ̵߳ľֲ combine ϲ뵥̵߳Ľͬ
+	{
+		ThreadPool pool(4);
+		auto countsSerial = group_accum<CountPolicy>(denseKeys.data(), groupValues.data(), records);
+		auto countsParallel = group_accum<CountPolicy>(pool, denseKeys.data(), groupValues.data(), records);
+		auto maxSerial = group_accum<MaxPolicy>(sparseKeys.data(), groupValues.data(), records);
+		auto maxParallel = group_accum<MaxPolicy>(pool, sparseKeys.data(), groupValues.data(), records);
+
+		bool same = countsSerial.size() == countsParallel.size() && maxSerial.size() == maxParallel.size();
+		countsSerial.for_each([&](int key, long total) {
+			same = same && *countsParallel.find(key) == total;
+		});
+		maxSerial.for_each([&](unsigned int key, long total) {
+			same = same && *maxParallel.find(key) == total;
+		});
+		std::cout << "CountPolicy / MaxPolicy, serial vs 4 threads : " << (same ? "same" : "DIFFERENT") << std::endl;
+	}
 
 	return 0;
 }
@@ -1,4 +1,18 @@
 #include <iostream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ACCUM_USE_SSE2 1
+#include <emmintrin.h>
+#endif
 
 // Ϊʵۻԣaccumulation policyѡ SumPolicy  MultPolicy ʵΪгԱģĳࡣ
 // һʹģƲӿڵķʽʱͿԱģģʹãtemplate template arguments;
@@ -90,12 +104,449 @@ auto accum(T const* beg, T const* end)
 	return total;
 }
 
+// һ򵥵Ĺ̶С̳߳أrun(f) óеỵ̈߳ԼΪ 0ִһ f(̱߳)
+// ̶ִ֮߳ŷء߳ run ֮ϣᷴ
+class ThreadPool
+{
+public:
+	explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency()) : generation(0), pending(0), stop(false)
+	{
+		if (threads == 0) {
+			threads = 1;
+		}
+		for (std::size_t i = 1; i < threads; i++) {
+			workers.emplace_back([this, i]() { workerLoop(i); });
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m);
+			stop = true;
+		}
+		cv.notify_all();
+		for (auto &it : workers) {
+			it.join();
+		}
+	}
+
+	std::size_t size() const
+	{
+		return workers.size() + 1;
+	}
+
+	template<typename F>
+	void run(F f)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m);
+			job = f;
+			generation++;
+			pending = workers.size();
+		}
+		cv.notify_all();
+
+		f(0);
+
+		std::unique_lock<std::mutex> lock(m);
+		doneCv.wait(lock, [this]() { return pending == 0; });
+	}
+
+private:
+	void workerLoop(std::size_t index)
+	{
+		std::size_t seen = 0;
+		for (;;) {
+			std::function<void(std::size_t)> current;
+			{
+				std::unique_lock<std::mutex> lock(m);
+				cv.wait(lock, [&]() { return stop || generation != seen; });
+				if (stop) {
+					return;
+				}
+				seen = generation;
+				current = job;
+			}
+
+			current(index);
+
+			std::lock_guard<std::mutex> lock(m);
+			if (--pending == 0) {
+				doneCv.notify_one();
+			}
+		}
+	}
+
+private:
+	std::vector<std::thread> workers;
+	std::mutex m;
+	std::condition_variable cv;
+	std::condition_variable doneCv;
+	std::function<void(std::size_t)> job;
+	std::size_t generation;
+	std::size_t pending;
+	bool stop;
+};
+
+// ÿ̸߳ԵĲֽvalue һе䣬
+// ￪ʼ̵߳ value ͬһϣα
+static constexpr std::size_t kCacheLine = 64;
+
+template<typename T>
+struct CachePadded
+{
+	T value;
+	char pad[kCacheLine];
+};
+
+// Ĭÿһ 256 KBһĵ L2 С
+static constexpr std::size_t kDefaultChunkBytes = 256 * 1024;
+
+// ̰߳汾 ȡʵ4 еֻͬǲͨģģ룻
+// ϲֽʱ AccTõ Policy<AccT, AccT>
+template<typename T,
+		 template<typename, typename>
+		 class Policy = SumPolicy,
+		 typename Traits = AccumulateTrait<T>>
+auto accum(ThreadPool &pool, T const* beg, T const* end, std::size_t chunkSize = kDefaultChunkBytes / sizeof(T))
+{
+	using AccT = typename Traits::AccT;
+	if (chunkSize == 0) {
+		chunkSize = 1; // ʱ
+	}
+	const std::size_t n = static_cast<std::size_t>(end - beg);
+	const std::size_t chunks = (n + chunkSize - 1) / chunkSize;
+	const std::size_t threads = pool.size();
+	std::vector<CachePadded<AccT>> partials(threads);
+
+	pool.run([&](std::size_t t) {
+		AccT total = Traits::zero();
+		for (std::size_t c = t; c < chunks; c += threads) {
+			T const* p = beg + c * chunkSize;
+			T const* last = c + 1 < chunks ? p + chunkSize : end;
+			while (p != last) {
+				Policy<AccT, T>::accumulate(total, *p);
+				++p;
+			}
+		}
+		partials[t].value = total;
+	});
+
+	AccT total = partials[0].value;
+	for (std::size_t t = 1; t < threads; t++) {
+		Policy<AccT, AccT>::accumulate(total, partials[t].value);
+	}
+	return total;
+}
+
+// ǰ׺ͣscanout[i]  beg[0] ... beg[i] ۻinclusive beg[0] ... beg[i - 1] ۻexclusiveout[0] Ϊʼֵ
+//  AccT accum() һȡչint ǰ׺ͲΪ; INT_MAX 
+// ScanKernel::run(in, n, out, carry)  carry ʼ n Ԫ inclusive scanۻ
+// ģԪص PolicyΪ SumPolicy ļֳṩ SSE2 汾
+template<typename T, typename AccT, template<typename, typename> class Policy>
+struct ScanKernel
+{
+	static AccT run(T const* in, std::size_t n, AccT *out, AccT carry)
+	{
+		for (std::size_t i = 0; i < n; i++) {
+			Policy<AccT, T>::accumulate(carry, in[i]);
+			out[i] = carry;
+		}
+		return carry;
+	}
+};
+
+#ifdef ACCUM_USE_SSE2
+// Ĵڵ scanx + (x һԪ) õԪصǰ׺ͣÿδ 4 룬õĴ s0s1
+// s1 ȼ s0 һԪأͬʱ֮ǰԪصۻ carry
+// ֻ carry һμӷÿ 4 ԪһΣԪصѭÿԪضҪһμӷɡ
+// ˳ۻͬλвstd::inclusive_scan ֤ͬ˳
+
+// int / unsigned int -> 64 λ
+template<bool Signed, typename T, typename AccT>
+AccT scanInt32To64(T const* in, std::size_t n, AccT *out, AccT total)
+{
+	std::size_t i = 0;
+	__m128i carry = _mm_set1_epi64x(static_cast<long long>(total));
+	for (; i + 4 <= n; i += 4) {
+		__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+		__m128i high = Signed ? _mm_srai_epi32(x, 31) : _mm_setzero_si128(); // չչĸ 32 λ
+		__m128i s0 = _mm_unpacklo_epi32(x, high);
+		__m128i s1 = _mm_unpackhi_epi32(x, high);
+		s0 = _mm_add_epi64(s0, _mm_slli_si128(s0, 8));
+		s1 = _mm_add_epi64(s1, _mm_slli_si128(s1, 8));
+		s1 = _mm_add_epi64(s1, _mm_shuffle_epi32(s0, _MM_SHUFFLE(3, 2, 3, 2)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi64(s0, carry));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 2), _mm_add_epi64(s1, carry));
+		carry = _mm_add_epi64(carry, _mm_shuffle_epi32(s1, _MM_SHUFFLE(3, 2, 3, 2)));
+	}
+
+	long long last;
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(&last), carry);
+	total = static_cast<AccT>(last);
+	for (; i < n; i++) {
+		total += in[i];
+		out[i] = total;
+	}
+	return total;
+}
+
+// 32 λ -> 32 λlong ֻ 32 λƽ̨ WindowsһĴ 4 Ԫأ޷
+template<typename T, typename AccT>
+AccT scanInt32(T const* in, std::size_t n, AccT *out, AccT total)
+{
+	std::size_t i = 0;
+	__m128i carry = _mm_set1_epi32(static_cast<int>(total));
+	for (; i + 4 <= n; i += 4) {
+		__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+		x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+		x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+		x = _mm_add_epi32(x, carry);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), x);
+		carry = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+	}
+
+	std::uint32_t last = static_cast<std::uint32_t>(_mm_cvtsi128_si32(carry));
+	for (; i < n; i++) {
+		last += static_cast<std::uint32_t>(in[i]);
+		out[i] = static_cast<AccT>(last);
+	}
+	return static_cast<AccT>(last);
+}
+
+template<bool Signed, typename T, typename AccT>
+AccT scanInt32Widen(T const* in, std::size_t n, AccT *out, AccT total)
+{
+	return sizeof(AccT) == 8 ? scanInt32To64<Signed>(in, n, out, total) : scanInt32(in, n, out, total);
+}
+
+template<>
+struct ScanKernel<int, long, SumPolicy>
+{
+	static long run(int const* in, std::size_t n, long *out, long carry)
+	{
+		return scanInt32Widen<true>(in, n, out, carry);
+	}
+};
+
+template<>
+struct ScanKernel<unsigned int, unsigned long, SumPolicy>
+{
+	static unsigned long run(unsigned int const* in, std::size_t n, unsigned long *out, unsigned long carry)
+	{
+		return scanInt32Widen<false>(in, n, out, carry);
+	}
+};
+
+// float -> double4  float תΪĴ double
+template<>
+struct ScanKernel<float, double, SumPolicy>
+{
+	static double run(float const* in, std::size_t n, double *out, double total)
+	{
+		std::size_t i = 0;
+		__m128d carry = _mm_set1_pd(total);
+		for (; i + 4 <= n; i += 4) {
+			__m128 x = _mm_loadu_ps(in + i);
+			__m128d s0 = _mm_cvtps_pd(x);
+			__m128d s1 = _mm_cvtps_pd(_mm_movehl_ps(x, x));
+			s0 = _mm_add_pd(s0, _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(s0), 8)));
+			s1 = _mm_add_pd(s1, _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(s1), 8)));
+			s1 = _mm_add_pd(s1, _mm_unpackhi_pd(s0, s0));
+			_mm_storeu_pd(out + i, _mm_add_pd(s0, carry));
+			_mm_storeu_pd(out + i + 2, _mm_add_pd(s1, carry));
+			carry = _mm_add_pd(carry, _mm_unpackhi_pd(s1, s1));
+		}
+
+		total = _mm_cvtsd_f64(carry);
+		for (; i < n; i++) {
+			total += in[i];
+			out[i] = total;
+		}
+		return total;
+	}
+};
+#endif
+
+template<typename T,
+		 template<typename, typename>
+		 class Policy = SumPolicy,
+		 typename Traits = AccumulateTrait<T>>
+void scan(T const* beg, T const* end, typename Traits::AccT *out)
+{
+	using AccT = typename Traits::AccT;
+	ScanKernel<T, AccT, Policy>::run(beg, static_cast<std::size_t>(end - beg), out, Traits::zero());
+}
+
+// exclusive scan ǰ inclusive scan Ľһλãout[0] Ϊʼֵout[1 .. n) Ϊǰ n - 1 Ԫص inclusive scan
+template<typename T,
+		 template<typename, typename>
+		 class Policy = SumPolicy,
+		 typename Traits = AccumulateTrait<T>>
+void exclusive_scan(T const* beg, T const* end, typename Traits::AccT *out)
+{
+	using AccT = typename Traits::AccT;
+	if (beg == end) {
+		return;
+	}
+	out[0] = Traits::zero();
+	ScanKernel<T, AccT, Policy>::run(beg, static_cast<std::size_t>(end - beg) - 1, out + 1, Traits::zero());
+}
+
+// һۻ4  total ۻ Policy<AccT, AccT> ϲ
+template<typename T, template<typename, typename> class Policy, typename Traits>
+typename Traits::AccT blockTotal(T const* p, std::size_t n)
+{
+	using AccT = typename Traits::AccT;
+	AccT t0 = Traits::zero(), t1 = Traits::zero(), t2 = Traits::zero(), t3 = Traits::zero();
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		Policy<AccT, T>::accumulate(t0, p[i]);
+		Policy<AccT, T>::accumulate(t1, p[i + 1]);
+		Policy<AccT, T>::accumulate(t2, p[i + 2]);
+		Policy<AccT, T>::accumulate(t3, p[i + 3]);
+	}
+	for (; i < n; i++) {
+		Policy<AccT, T>::accumulate(t0, p[i]);
+	}
+	Policy<AccT, AccT>::accumulate(t0, t1);
+	Policy<AccT, AccT>::accumulate(t2, t3);
+	Policy<AccT, AccT>::accumulate(t0, t2);
+	return t0;
+}
+
+// ̵߳ scan飨reduce-then-scan
+// һÿ߳ԼЩ飨ֿ鷽ʽ̵߳ accum() ͬۻ
+// ߶ЩĽһδе exclusive scanõÿһĳʼֵĸ٣һԺԣ
+// ڶÿ̴߳ӸԵĳʼֵʼ ScanKernel дԼЩǰ׺͡
+// 顢дһ飬ȡȸ scan ٸÿһƫơٶдһ
+template<typename T,
+		 template<typename, typename>
+		 class Policy = SumPolicy,
+		 typename Traits = AccumulateTrait<T>>
+void scan(ThreadPool &pool, T const* beg, T const* end, typename Traits::AccT *out, bool inclusive = true,
+		  std::size_t chunkSize = kDefaultChunkBytes / sizeof(T))
+{
+	using AccT = typename Traits::AccT;
+	if (chunkSize == 0) {
+		chunkSize = 1; // ʱ
+	}
+	const std::size_t n = static_cast<std::size_t>(end - beg);
+	const std::size_t chunks = (n + chunkSize - 1) / chunkSize;
+	const std::size_t threads = pool.size();
+	std::vector<AccT> offsets(chunks + 1); // ÿֻдһΣ鹲еĴۿԺ
+
+	pool.run([&](std::size_t t) {
+		for (std::size_t c = t; c < chunks; c += threads) {
+			std::size_t first = c * chunkSize;
+			offsets[c + 1] = blockTotal<T, Policy, Traits>(beg + first, std::min(chunkSize, n - first));
+		}
+	});
+
+	offsets[0] = Traits::zero();
+	for (std::size_t c = 1; c <= chunks; c++) {
+		Policy<AccT, AccT>::accumulate(offsets[c], offsets[c - 1]);
+	}
+
+	pool.run([&](std::size_t t) {
+		for (std::size_t c = t; c < chunks; c += threads) {
+			std::size_t first = c * chunkSize;
+			std::size_t count = std::min(chunkSize, n - first);
+			if (inclusive) {
+				ScanKernel<T, AccT, Policy>::run(beg + first, count, out + first, offsets[c]);
+			}
+			else {
+				out[first] = offsets[c];
+				ScanKernel<T, AccT, Policy>::run(beg + first, count - 1, out + first + 1, offsets[c]);
+			}
+		}
+	});
+}
+
 int main()
 {
 	// create array of 5 integer values 
 	int num[] = { 1, 2, 3, 4, 5 };
 	// print product of all values 
 	std::cout << "the product of the integer values is " << accum<int, SumPolicy>(num, num + 5) << std::endl;
-	
+
+	// 256 MB  float߳ʹȫӲ̵߳Ľͺʱ
+	std::vector<float> data((std::size_t(256) << 20) / sizeof(float));
+	for (std::size_t i = 0; i < data.size(); i++) {
+		data[i] = static_cast<float>(i % 1000) * 0.5f;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	double serial = accum(data.data(), data.data() + data.size());
+	std::chrono::duration<double, std::milli> serialMs = std::chrono::steady_clock::now() - start;
+
+	ThreadPool pool;
+	start = std::chrono::steady_clock::now();
+	double parallel = accum(pool, data.data(), data.data() + data.size());
+	std::chrono::duration<double, std::milli> parallelMs = std::chrono::steady_clock::now() - start;
+
+	std::cout << "serial             : " << serialMs.count() << " ms, sum = " << serial << std::endl;
+	std::cout << pool.size() << " threads          : " << parallelMs.count() << " ms, sum = " << parallel << std::endl;
+
+	// ǰ׺ͣ3200  int  3200  floatԪۻѭȽϡ
+	// int  -500 ~ 500 ֮䣬ÿ 1001 һڣǰ׺͵ľֵ 12.6 Windows  AccumulateTrait<int>::AccTlongֻ 32 λ
+	// οѭ long long ۻstd::partial_sum  int ۻ
+	// float  0.5 double ǰ׺û̵߳ĽӦ뵥̵߳λͬ
+	const std::size_t scanCount = std::size_t(32) << 20;
+	std::vector<int> ints(scanCount);
+	for (std::size_t i = 0; i < scanCount; i++) {
+		ints[i] = static_cast<int>((i * 2654435761u) % 1001) - 500;
+	}
+	std::vector<long> intOut(scanCount);
+	std::vector<long> intPool(scanCount);
+	std::vector<long long> intRef(scanCount);
+	std::vector<double> floatOut(scanCount);
+	std::vector<double> floatPool(scanCount);
+	std::vector<double> floatRef(scanCount);
+
+	auto scanBenchmark = [](const char *name, std::size_t bytes, auto f) {
+		f(); // ԤȣһдʱҪҳ
+		auto t0 = std::chrono::steady_clock::now();
+		f();
+		std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - t0;
+		std::cout << name << " : " << ms.count() << " ms, " << bytes / ms.count() / 1e6 << " GB/s" << std::endl;
+	};
+	auto sameAs = [](auto const &a, auto const &b) {
+		return std::equal(a.begin(), a.end(), b.begin());
+	};
+
+	const int *ib = ints.data();
+	const int *ie = ib + scanCount;
+	const float *fb = data.data();
+	const float *fe = fb + scanCount;
+	const std::size_t intBytes = scanCount * (sizeof(int) + sizeof(long));
+	const std::size_t floatBytes = scanCount * (sizeof(float) + sizeof(double));
+
+	scanBenchmark("loop                  int   -> long long", scanCount * (sizeof(int) + sizeof(long long)), [&]() {
+		long long total = 0;
+		for (std::size_t i = 0; i < scanCount; i++) {
+			total += ib[i];
+			intRef[i] = total;
+		}
+	});
+	scanBenchmark("loop                  float -> double   ", floatBytes, [&]() {
+		double total = 0;
+		for (std::size_t i = 0; i < scanCount; i++) {
+			total += fb[i];
+			floatRef[i] = total;
+		}
+	});
+	scanBenchmark("scan                  int   -> long     ", intBytes, [&]() { scan(ib, ie, intOut.data()); });
+	scanBenchmark("scan                  float -> double   ", floatBytes, [&]() { scan(fb, fe, floatOut.data()); });
+	scanBenchmark("scan(pool)            int   -> long     ", intBytes, [&]() { scan(pool, ib, ie, intPool.data()); });
+	scanBenchmark("scan(pool)            float -> double   ", floatBytes, [&]() { scan(pool, fb, fe, floatPool.data()); });
+	std::cout << "scan vs loop : int " << (sameAs(intOut, intRef) ? "same" : "DIFFERENT") << ", float " << (sameAs(floatOut, floatRef) ? "same" : "DIFFERENT")
+			  << "; scan(pool) vs scan : int " << (sameAs(intPool, intOut) ? "same" : "DIFFERENT") << ", float "
+			  << (sameAs(floatPool, floatOut) ? "same" : "DIFFERENT") << std::endl;
+
 	return 0;
 }
\ No newline at end of file
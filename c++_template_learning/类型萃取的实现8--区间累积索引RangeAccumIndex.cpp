@@ -0,0 +1,352 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/* ȡӦ-- AccumulateTrait  Policy ۻ RangeAccumIndex */
+
+// ȡʵ4--PolicyԼ.cpp е AccumulateTraitԼ initialValue()
+template<typename T>
+struct AccumulateTrait;
+
+template<>
+struct AccumulateTrait<char>
+{
+	using AccT = int;
+	static constexpr AccT zero()
+	{
+		return 0;
+	}
+};
+
+template<>
+struct AccumulateTrait<short>
+{
+	using AccT = int;
+	static constexpr AccT zero()
+	{
+		return 0;
+	}
+};
+
+template<>
+struct AccumulateTrait<int>
+{
+	using AccT = long;
+	static constexpr AccT zero()
+	{
+		return 0;
+	}
+};
+
+template<>
+struct AccumulateTrait<unsigned int>
+{
+	using AccT = unsigned long;
+	static constexpr AccT zero()
+	{
+		return 0;
+	}
+};
+
+template<>
+struct AccumulateTrait<float>
+{
+	using AccT = double;
+
+	static constexpr AccT zero()
+	{
+		return 0;
+	}
+};
+
+class SumPolicy {
+public:
+	template<typename T1>
+	static constexpr T1 identity() {
+		return 0;
+	}
+
+	template<typename T1, typename T2>
+	static void accumulate(T1& total, T2 const& value) {
+		total += value;
+	}
+};
+
+class MultPolicy
+{
+public:
+	template<typename T1>
+	static constexpr T1 identity() {
+		return 1;
+	}
+
+	template<typename T1, typename T2>
+	static void accumulate(T1& total, T2 const& value) {
+		total *= value;
+	}
+};
+
+class MinPolicy
+{
+public:
+	template<typename T1>
+	static constexpr T1 identity() {
+		return std::numeric_limits<T1>::max();
+	}
+
+	template<typename T1, typename T2>
+	static void accumulate(T1& total, T2 const& value) {
+		if (value < total) {
+			total = value;
+		}
+	}
+};
+
+class MaxPolicy
+{
+public:
+	template<typename T1>
+	static constexpr T1 identity() {
+		return std::numeric_limits<T1>::lowest();
+	}
+
+	template<typename T1, typename T2>
+	static void accumulate(T1& total, T2 const& value) {
+		if (total < value) {
+			total = value;
+		}
+	}
+};
+
+template<typename Policy, typename Traits>
+auto initialValue(int) -> decltype(Policy::template identity<typename Traits::AccT>())
+{
+	return Policy::template identity<typename Traits::AccT>();
+}
+
+template<typename Policy, typename Traits>
+typename Traits::AccT initialValue(long)
+{
+	return Traits::zero();
+}
+
+template<typename T, typename Policy = SumPolicy, typename Traits = AccumulateTrait<T>>
+auto accum(T const* beg, T const* end) {
+	using AccT = typename Traits::AccT;
+	AccT total = initialValue<Policy, Traits>(0);
+	while (beg != end) {
+		Policy::accumulate(total, *beg);
+		++beg;
+	}
+	return total;
+}
+
+// ͬһϷԲͬ accum()ÿζ O(n)黹ᱻԪص޸ģ޷Ԥд𰸡
+// RangeAccumIndex һðзֿ߶
+// ҪһԪذ Block һ飨ĬһУ֣ÿһۻ߶һҶӣ
+//         ĴСֻ 1/BlockҲ log2(Block) 㣬ѯʱʵڵڻУ
+// Ҫquery(first, last) Ľ accum(data + first, data + last) ͬ
+//         ˲ֱԪۻм߶ԵϺϲO(Block + log n)
+// Ҫupdate(i, value) ¼ i ڵ飬ϸ£O(Block + log n)
+// ҪģʱÿһĽԵϽO(n)
+// ϲֽʱʹ Policy::accumulate(AccT&, AccT)ԲԱɣSumPolicyMultPolicyMinPolicyMaxPolicy 㣩
+//  identity() ǵλԪϲʱʼձǰұں
+static constexpr std::size_t kCacheLine = 64;
+
+template<typename T,
+		 typename Policy = SumPolicy,
+		 typename Traits = AccumulateTrait<T>,
+		 std::size_t Block = (kCacheLine / sizeof(T) > 0 ? kCacheLine / sizeof(T) : 1)>
+class RangeAccumIndex
+{
+public:
+	using AccT = typename Traits::AccT;
+
+	RangeAccumIndex(T const* beg, T const* end) : values(beg, end), identity(initialValue<Policy, Traits>(0))
+	{
+		const std::size_t blocks = (values.size() + Block - 1) / Block;
+		leaves = 1;
+		while (leaves < blocks) {
+			leaves *= 2;
+		}
+
+		// ҶӸΪ 2 ݣҶǵλԪ˳ʼ˳һ
+		tree.assign(2 * leaves, identity);
+		for (std::size_t b = 0; b < blocks; b++) {
+			tree[leaves + b] = blockTotal(b);
+		}
+		for (std::size_t p = leaves - 1; p > 0; p--) {
+			pull(p);
+		}
+	}
+
+	std::size_t size() const
+	{
+		return values.size();
+	}
+
+	const T& operator[](std::size_t i) const
+	{
+		return values[i];
+	}
+
+	void update(std::size_t i, const T &value)
+	{
+		assert(i < values.size());
+
+		values[i] = value;
+		std::size_t p = leaves + i / Block;
+		tree[p] = blockTotal(i / Block);
+		for (p /= 2; p > 0; p /= 2) {
+			pull(p);
+		}
+	}
+
+	// [first, last) ۻ
+	AccT query(std::size_t first, std::size_t last) const
+	{
+		assert(first <= last && last <= values.size());
+
+		const std::size_t firstBlock = (first + Block - 1) / Block; // һ
+		const std::size_t lastBlock = last / Block;                 // һ֮һ
+		if (firstBlock >= lastBlock) {
+			// ûиκ飬飬ֱۻ
+			return linear(identity, first, last);
+		}
+
+		AccT left = linear(identity, first, firstBlock * Block);
+		AccT right = identity;
+		for (std::size_t l = leaves + firstBlock, r = leaves + lastBlock; l < r; l /= 2, r /= 2) {
+			if (l & 1) {
+				Policy::accumulate(left, tree[l++]);
+			}
+			if (r & 1) {
+				AccT t = tree[--r];
+				Policy::accumulate(t, right);
+				right = t;
+			}
+		}
+		Policy::accumulate(left, right);
+		return linear(left, lastBlock * Block, last);
+	}
+
+private:
+	AccT linear(AccT total, std::size_t first, std::size_t last) const
+	{
+		for (std::size_t i = first; i < last; i++) {
+			Policy::accumulate(total, values[i]);
+		}
+		return total;
+	}
+
+	AccT blockTotal(std::size_t b) const
+	{
+		std::size_t first = b * Block;
+		std::size_t last = first + Block < values.size() ? first + Block : values.size();
+		return linear(identity, first, last);
+	}
+
+	void pull(std::size_t p)
+	{
+		AccT t = tree[2 * p];
+		Policy::accumulate(t, tree[2 * p + 1]);
+		tree[p] = t;
+	}
+
+private:
+	std::vector<T> values;
+	std::vector<AccT> tree; // tree[1] Ǹtree[leaves + b] ǵ b ۻ
+	AccT identity;
+	std::size_t leaves;
+};
+
+int main()
+{
+	int num[] = { 5, 3, 8, 1, 9, 2, 7, 4, 6, 0 };
+	RangeAccumIndex<int> sums(num, num + 10);
+	RangeAccumIndex<int, MinPolicy, AccumulateTrait<int>, 2> mins(num, num + 10); // ÿֻ 2 Ԫأ۲
+	std::cout << "sum [2, 7) = " << sums.query(2, 7) << ", min [2, 7) = " << mins.query(2, 7) << std::endl;
+	sums.update(3, 100);
+	mins.update(5, -1);
+	std::cout << "after update : sum [2, 7) = " << sums.query(2, 7) << ", min [2, 7) = " << mins.query(2, 7) << std::endl;
+
+	// 100  int ϵѯÿ 10 βһǵ޸ģ
+	// ÿζ accum()  RangeAccumIndex Ƚϣaccum() ֻ̫ǰ 5000 β˶Խ
+	const std::size_t n = 1000000;
+	std::vector<int> data(n);
+	for (std::size_t i = 0; i < n; i++) {
+		data[i] = static_cast<int>((i * 2654435761u) % 1000);
+	}
+
+	struct Op
+	{
+		bool isUpdate;
+		std::size_t a;
+		std::size_t b;
+	};
+	const std::size_t opCount = 1000000;
+	std::vector<Op> ops(opCount);
+	std::uint32_t seed = 12345;
+	auto next = [&seed]() {
+		seed = seed * 1664525u + 1013904223u;
+		return seed >> 8;
+	};
+	for (auto &op : ops) {
+		op.isUpdate = next() % 10 == 0;
+		op.a = next() % n;
+		op.b = op.isUpdate ? next() % 1000 : next() % n;
+		if (!op.isUpdate && op.b < op.a) {
+			std::size_t t = op.a;
+			op.a = op.b;
+			op.b = t;
+		}
+	}
+
+	const std::size_t naiveOps = 5000;
+	std::vector<long> naiveResults;
+	auto start = std::chrono::steady_clock::now();
+	for (std::size_t k = 0; k < naiveOps; k++) {
+		if (ops[k].isUpdate) {
+			data[ops[k].a] = static_cast<int>(ops[k].b);
+		}
+		else {
+			naiveResults.push_back(accum(data.data() + ops[k].a, data.data() + ops[k].b));
+		}
+	}
+	std::chrono::duration<double, std::milli> naiveMs = std::chrono::steady_clock::now() - start;
+
+	for (std::size_t i = 0; i < n; i++) {
+		data[i] = static_cast<int>((i * 2654435761u) % 1000);
+	}
+
+	start = std::chrono::steady_clock::now();
+	RangeAccumIndex<int> index(data.data(), data.data() + n);
+	std::chrono::duration<double, std::milli> buildMs = std::chrono::steady_clock::now() - start;
+
+	std::vector<long> indexResults;
+	long long checksum = 0; // ۼԼ 1.5e14Windows ϵ long ֻ 32 λ
+	start = std::chrono::steady_clock::now();
+	for (std::size_t k = 0; k < opCount; k++) {
+		if (ops[k].isUpdate) {
+			index.update(ops[k].a, static_cast<int>(ops[k].b));
+		}
+		else {
+			long result = index.query(ops[k].a, ops[k].b);
+			checksum += result;
+			if (k < naiveOps) {
+				indexResults.push_back(result);
+			}
+		}
+	}
+	std::chrono::duration<double, std::milli> indexMs = std::chrono::steady_clock::now() - start;
+
+	std::cout << "accum()         : " << naiveMs.count() * 1000 / naiveOps << " us per operation" << std::endl;
+	std::cout << "RangeAccumIndex : " << indexMs.count() * 1000 / opCount << " us per operation, build " << buildMs.count()
+			  << " ms, checksum " << checksum << ", " << (naiveResults == indexResults ? "same" : "DIFFERENT") << " results" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,484 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+/* ȡӦ--ѡ㷨̯ O(1) µĻۻ SlidingWindow */
+
+// ȡʵ4--PolicyԼ.cpp е AccumulateTraitԼ initialValue()
+template<typename T>
+struct AccumulateTrait;
+
+template<>
+struct AccumulateTrait<char>
+{
+	using AccT = int;
+	static constexpr AccT zero()
+	{
+		return 0;
+	}
+};
+
+template<>
+struct AccumulateTrait<short>
+{
+	using AccT = int;
+	static constexpr AccT zero()
+	{
+		return 0;
+	}
+};
+
+template<>
+struct AccumulateTrait<int>
+{
+	using AccT = long;
+	static constexpr AccT zero()
+	{
+		return 0;
+	}
+};
+
+template<>
+struct AccumulateTrait<unsigned int>
+{
+	using AccT = unsigned long;
+	static constexpr AccT zero()
+	{
+		return 0;
+	}
+};
+
+template<>
+struct AccumulateTrait<float>
+{
+	using AccT = double;
+
+	static constexpr AccT zero()
+	{
+		return 0;
+	}
+};
+
+// Ϳԡһֵ뿪ʱ total мȥɡĲԶṩ deaccumulate(total, value)
+class SumPolicy {
+public:
+	template<typename T1>
+	static constexpr T1 identity() {
+		return 0;
+	}
+
+	template<typename T1, typename T2>
+	static void accumulate(T1& total, T2 const& value) {
+		total += value;
+	}
+
+	template<typename T1, typename T2>
+	static void deaccumulate(T1& total, T2 const& value) {
+		total -= value;
+	}
+};
+
+// ˻óֻҪйһ 0˻Զ 0 ˣĳҲᶪ
+class MultPolicy
+{
+public:
+	template<typename T1>
+	static constexpr T1 identity() {
+		return 1;
+	}
+
+	template<typename T1, typename T2>
+	static void accumulate(T1& total, T2 const& value) {
+		total *= value;
+	}
+};
+
+class MinPolicy
+{
+public:
+	template<typename T1>
+	static constexpr T1 identity() {
+		return std::numeric_limits<T1>::max();
+	}
+
+	template<typename T1, typename T2>
+	static void accumulate(T1& total, T2 const& value) {
+		if (value < total) {
+			total = value;
+		}
+	}
+};
+
+class MaxPolicy
+{
+public:
+	template<typename T1>
+	static constexpr T1 identity() {
+		return std::numeric_limits<T1>::lowest();
+	}
+
+	template<typename T1, typename T2>
+	static void accumulate(T1& total, T2 const& value) {
+		if (total < value) {
+			total = value;
+		}
+	}
+};
+
+template<typename Policy, typename Traits>
+auto initialValue(int) -> decltype(Policy::template identity<typename Traits::AccT>())
+{
+	return Policy::template identity<typename Traits::AccT>();
+}
+
+template<typename Policy, typename Traits>
+typename Traits::AccT initialValue(long)
+{
+	return Traits::zero();
+}
+
+template<typename T, typename Policy = SumPolicy, typename Traits = AccumulateTrait<T>>
+auto accum(T const* beg, T const* end) {
+	using AccT = typename Traits::AccT;
+	AccT total = initialValue<Policy, Traits>(0);
+	while (beg != end) {
+		Policy::accumulate(total, *beg);
+		++beg;
+	}
+	return total;
+}
+
+// ǷԳǷṩ deaccumulate(AccT&, T)
+template<typename...>
+using VoidT = void;
+
+template<typename Policy, typename AccT, typename T, typename = VoidT<>>
+struct IsInvertibleT : std::false_type
+{
+
+};
+
+template<typename Policy, typename AccT, typename T>
+struct IsInvertibleT<Policy, AccT, T, VoidT<decltype(Policy::deaccumulate(std::declval<AccT&>(), std::declval<T const&>()))>> : std::true_type
+{
+
+};
+
+// ̶Ļλ capacity ± 0 ɵһ
+template<typename T>
+class RingBuffer
+{
+public:
+	explicit RingBuffer(std::size_t capacity) : buf(capacity), head(0), count(0)
+	{
+		assert(capacity > 0);
+	}
+
+	std::size_t size() const
+	{
+		return count;
+	}
+
+	std::size_t capacity() const
+	{
+		return buf.size();
+	}
+
+	bool full() const
+	{
+		return count == buf.size();
+	}
+
+	//  i  buf еλ
+	std::size_t index(std::size_t i) const
+	{
+		std::size_t p = head + i;
+		return p < buf.size() ? p : p - buf.size();
+	}
+
+	const T& operator[](std::size_t i) const
+	{
+		return buf[index(i)];
+	}
+
+	const T& front() const
+	{
+		assert(count > 0);
+		return buf[head];
+	}
+
+	void push_back(const T &value)
+	{
+		assert(!full());
+		buf[index(count)] = value;
+		count++;
+	}
+
+	void pop_front()
+	{
+		assert(count > 0);
+		head = index(1);
+		count--;
+	}
+
+	//  buf еĴ˳򣬷طf(ָ, )
+	template<typename F>
+	void for_each_segment(F f) const
+	{
+		std::size_t first = buf.size() - head < count ? buf.size() - head : count;
+		f(buf.data() + head, first);
+		if (first < count) {
+			f(buf.data(), count - first);
+		}
+	}
+
+private:
+	std::vector<T> buf;
+	std::size_t head;
+	std::size_t count;
+};
+
+// ɳĲԣʱ accumulateɵ뿪ʱ deaccumulateÿθ O(1)
+// ļӼۻ AccT ǸʱÿһھʹӻλۻһΣ̯ O(1)
+template<typename T, typename Policy = SumPolicy, typename Traits = AccumulateTrait<T>>
+class InvertibleWindow
+{
+public:
+	using AccT = typename Traits::AccT;
+
+	explicit InvertibleWindow(std::size_t window) : samples(window), total(initialValue<Policy, Traits>(0)), evicted(0)
+	{
+
+	}
+
+	void push(const T &value)
+	{
+		if (samples.full()) {
+			Policy::deaccumulate(total, samples.front());
+			samples.pop_front();
+			if (std::is_floating_point<AccT>::value && ++evicted == samples.capacity()) {
+				evicted = 0;
+				recompute();
+			}
+		}
+		samples.push_back(value);
+		Policy::accumulate(total, value);
+	}
+
+	AccT result() const
+	{
+		return total;
+	}
+
+	std::size_t size() const
+	{
+		return samples.size();
+	}
+
+private:
+	void recompute()
+	{
+		total = initialValue<Policy, Traits>(0);
+		samples.for_each_segment([this](T const* p, std::size_t n) {
+			for (std::size_t i = 0; i < n; i++) {
+				Policy::accumulate(total, p[i]);
+			}
+		});
+	}
+
+private:
+	RingBuffer<T> samples;
+	AccT total;
+	std::size_t evicted;
+};
+
+// ɳĲԣ˻СֵֵջĶС
+// еΪ֣Ͼɵġǰ벿֡Ϊÿһ׺ suffixԼԼֱ֮ǰ벿ĩβۻ
+// µġ벿ֻ֡һۻ back
+// Ҫһresult() = ǰ벿ֵһ suffix ϲ backO(1)
+// Ҫʱֻϲ back ϣO(1)ɵ뿪ʱֻҪǰ벿һ
+// Ҫǰ벿ʱѵǰµ¼һ suffixȫǰ벿֣back ա
+//         һ O(W)ÿ W θ²ŷһΣ̯ÿθ O(1)
+// suffix 뻷λͬλôţҪջṹֻҪɣϲʱʼձ־ɵǰµں
+template<typename T, typename Policy = SumPolicy, typename Traits = AccumulateTrait<T>>
+class TwoStackWindow
+{
+public:
+	using AccT = typename Traits::AccT;
+
+	explicit TwoStackWindow(std::size_t window)
+		: samples(window), suffix(window), identity(initialValue<Policy, Traits>(0)), back(identity), frontCount(0)
+	{
+
+	}
+
+	void push(const T &value)
+	{
+		if (samples.full()) {
+			if (frontCount == 0) {
+				flip();
+			}
+			samples.pop_front();
+			frontCount--;
+		}
+		samples.push_back(value);
+		Policy::accumulate(back, value);
+	}
+
+	AccT result() const
+	{
+		if (frontCount == 0) {
+			return back;
+		}
+
+		AccT total = suffix[samples.index(0)];
+		Policy::accumulate(total, back);
+		return total;
+	}
+
+	std::size_t size() const
+	{
+		return samples.size();
+	}
+
+private:
+	void flip()
+	{
+		AccT total = identity;
+		for (std::size_t i = samples.size(); i-- > 0;) {
+			AccT t = identity;
+			Policy::accumulate(t, samples[i]);
+			Policy::accumulate(t, total);
+			total = t;
+			suffix[samples.index(i)] = total;
+		}
+		frontCount = samples.size();
+		back = identity;
+	}
+
+private:
+	RingBuffer<T> samples;
+	std::vector<AccT> suffix;
+	AccT identity;
+	AccT back;
+	std::size_t frontCount;
+};
+
+// SlidingWindow<T, Policy>ԿԳʱ InvertibleWindow TwoStackWindow
+template<typename T, typename Policy = SumPolicy, typename Traits = AccumulateTrait<T>>
+using SlidingWindow = typename std::conditional<IsInvertibleT<Policy, typename Traits::AccT, T>::value,
+												InvertibleWindow<T, Policy, Traits>,
+												TwoStackWindow<T, Policy, Traits>>::type;
+
+// գÿʱ W µһ accum()
+template<typename T, typename Policy = SumPolicy, typename Traits = AccumulateTrait<T>>
+class RecomputeWindow
+{
+public:
+	using AccT = typename Traits::AccT;
+
+	explicit RecomputeWindow(std::size_t window) : samples(window)
+	{
+
+	}
+
+	void push(const T &value)
+	{
+		if (samples.full()) {
+			samples.pop_front();
+		}
+		samples.push_back(value);
+	}
+
+	AccT result() const
+	{
+		AccT total = initialValue<Policy, Traits>(0);
+		samples.for_each_segment([&total](T const* p, std::size_t n) {
+			Policy::accumulate(total, accum<T, Policy, Traits>(p, p + n));
+		});
+		return total;
+	}
+
+private:
+	RingBuffer<T> samples;
+};
+
+// ÿθ£ѹһȡĺʱλ롣
+// ȰѴʱƽֵʱ㣬λֵμʱõ
+template<typename Window, typename T>
+void latency(const char *name, std::size_t window, const std::vector<T> &samples, std::size_t ticks)
+{
+	Window w(window);
+	for (std::size_t i = 0; i < window; i++) {
+		w.push(samples[i % samples.size()]);
+	}
+
+	double checksum = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < ticks; i++) {
+		w.push(samples[(window + i) % samples.size()]);
+		checksum += static_cast<double>(w.result());
+	}
+	std::chrono::duration<double, std::nano> total = std::chrono::steady_clock::now() - start;
+
+	std::vector<double> each(ticks);
+	for (std::size_t i = 0; i < ticks; i++) {
+		auto t0 = std::chrono::steady_clock::now();
+		w.push(samples[i % samples.size()]);
+		checksum += static_cast<double>(w.result());
+		std::chrono::duration<double, std::nano> ns = std::chrono::steady_clock::now() - t0;
+		each[i] = ns.count();
+	}
+
+	// ֵҲ̱߳ϵͳȥʱ䣬ͬʱ 99.9% λ
+	std::sort(each.begin(), each.end());
+	std::cout << name << " W = " << window << " : " << total.count() / ticks << " ns mean, " << each[ticks - 1 - ticks / 1000] << " ns p99.9, "
+			  << each.back() << " ns worst (checksum " << checksum << ")" << std::endl;
+}
+
+int main()
+{
+	int num[] = { 3, 1, 4, 1, 5, 9, 2, 6, 5, 3 };
+	SlidingWindow<int> sums(3);
+	SlidingWindow<int, MaxPolicy> maxes(3);
+	SlidingWindow<int, MultPolicy> products(3);
+	for (int v : num) {
+		sums.push(v);
+		maxes.push(v);
+		products.push(v);
+		std::cout << v << " -> sum " << sums.result() << ", max " << maxes.result() << ", product " << products.result() << std::endl;
+	}
+
+	// ˻г 00 뿪֮󣬳˻ָΪ
+	SlidingWindow<float, MultPolicy> product(2);
+	float withZero[] = { 2.0f, 0.0f, 3.0f, 4.0f };
+	for (float v : withZero) {
+		product.push(v);
+		std::cout << "product of last 2 = " << product.result() << std::endl;
+	}
+
+	// ÿθµĺʱW  10^3  10^6 accum() İ汾ֻ 10^8 / W θ
+	std::vector<int> samples(std::size_t(1) << 21);
+	std::uint32_t seed = 12345;
+	for (auto &it : samples) {
+		seed = seed * 1664525u + 1013904223u;
+		it = static_cast<int>(seed >> 22) - 512;
+	}
+
+	const std::size_t ticks = 2000000;
+	for (std::size_t window = 1000; window <= 1000000; window *= 10) {
+		latency<RecomputeWindow<int>>("recompute accum()       sum", window, samples, 100000000 / window);
+		latency<SlidingWindow<int>>("SlidingWindow (inverse) sum", window, samples, ticks);
+		latency<RecomputeWindow<int, MaxPolicy>>("recompute accum()       max", window, samples, 100000000 / window);
+		latency<SlidingWindow<int, MaxPolicy>>("SlidingWindow (2 stack) max", window, samples, ticks);
+	}
+
+	return 0;
+}
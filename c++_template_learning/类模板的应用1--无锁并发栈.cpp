@@ -0,0 +1,337 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cassert>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+
+/* ģӦ--ջTreiber Stack 6_ģ.cpp е Stack Ϊ */
+
+// 6_ģ.cpp е Stack<T>вֱ std::vector ϣֻڵ߳ʹ
+template<typename T>
+class Stack
+{
+public:
+	Stack()
+	{
+		std::cout << "-------------- Template Stack ------------" << std::endl;
+	}
+
+	void push(const T &elem)
+	{
+		s.push_back(elem);
+	}
+
+	void pop()
+	{
+		assert(!s.empty());
+
+		s.pop_back();
+	}
+
+	const T& top()
+	{
+		assert(!s.empty());
+
+		return s.back();
+	}
+
+	bool empty() const
+	{
+		return s.empty();
+	}
+
+private:
+	std::vector<T> s;
+};
+
+// ̹߳ʱֱӵǸ Stack һѻ
+// ע⣺top() + pop() ε֮߳̿Ѿջϲһ try_pop()
+template<typename T>
+class MutexStack
+{
+public:
+	void push(const T &elem)
+	{
+		std::lock_guard<std::mutex> lock(m);
+		s.push(elem);
+	}
+
+	bool try_pop(T &out)
+	{
+		std::lock_guard<std::mutex> lock(m);
+		if (s.empty()) {
+			return false;
+		}
+
+		out = s.top();
+		s.pop();
+		return true;
+	}
+
+private:
+	std::mutex m;
+	Stack<T> s;
+};
+
+// ջջֻһԭӱpush/pop ͨ CAScompare_exchange޸
+// ҪһABA ⡣߳ 1 ջ A  A->nextûü CAS߳ 2  A Bѹ A
+//         ʱ߳ 1  CAS Ȼɹдص next ʧЧ
+//         취Ǹջһ汾ţtagÿ޸ջ tag һCAS ͬʱȽ± tag
+// ҪΪ {ڵ, tag} Ž 64 λԭӱ 32 λ 64 λƽ̨϶ lock-free ģ
+//         ڵ㲻ָ 32 λ±ʾڵӰĽڵȡá
+// ҪĽڵŻؿظʹãֱջͷڴ棬
+//         ̼߳ʹһڡĽڵ㣬ҲȻЧڴ棨 CAS Ϊ tag ͬʧܣ
+template<typename T>
+class ConcurrentStack
+{
+	struct Node
+	{
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+		std::atomic<std::uint32_t> next;
+
+		T* value()
+		{
+			return reinterpret_cast<T*>(&storage);
+		}
+	};
+
+	static constexpr std::uint32_t kNull = 0xffffffffu;
+	static constexpr std::uint32_t kFirstChunkSize = 1024; //  k  kFirstChunkSize << k ڵ
+	static constexpr int kMaxChunks = 22;                  // ԼΪ 1024 * 2^22 ڵ
+
+public:
+	ConcurrentStack() : head(pack(kNull, 0)), freeList(pack(kNull, 0)), fresh(0)
+	{
+		for (int i = 0; i < kMaxChunks; i++) {
+			chunks[i].store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	ConcurrentStack(const ConcurrentStack&) = delete;
+	ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+	~ConcurrentStack()
+	{
+		std::uint32_t idx;
+		while ((idx = popIndex(head)) != kNull) {
+			node(idx).value()->~T();
+		}
+
+		for (int i = 0; i < kMaxChunks; i++) {
+			delete[] chunks[i].load(std::memory_order_relaxed);
+		}
+	}
+
+	void push(const T &elem)
+	{
+		emplace(elem);
+	}
+
+	void push(T &&elem)
+	{
+		emplace(std::move(elem));
+	}
+
+	template<typename... Args>
+	void emplace(Args&&... args)
+	{
+		std::uint32_t idx = allocNode();
+		try {
+			new (node(idx).value()) T(std::forward<Args>(args)...);
+		}
+		catch (...) {
+			pushIndex(freeList, idx);
+			throw;
+		}
+
+		pushIndex(head, idx);
+	}
+
+	// ȡ top() + pop()ջΪʱ falseջƶ out в
+	bool try_pop(T &out)
+	{
+		std::uint32_t idx = popIndex(head);
+		if (idx == kNull) {
+			return false;
+		}
+
+		// CAS ɹ֮ڵֻڵǰ̣߳Էĵضȡֵ
+		T *value = node(idx).value();
+		out = std::move(*value);
+		value->~T();
+
+		pushIndex(freeList, idx);
+		return true;
+	}
+
+	// ֻһ˲ʱĿգ֮߳̿Ѿ޸ջ
+	bool empty() const
+	{
+		return indexOf(head.load(std::memory_order_acquire)) == kNull;
+	}
+
+private:
+	static std::uint64_t pack(std::uint32_t idx, std::uint32_t tag)
+	{
+		return (static_cast<std::uint64_t>(tag) << 32) | idx;
+	}
+
+	static std::uint32_t indexOf(std::uint64_t word)
+	{
+		return static_cast<std::uint32_t>(word);
+	}
+
+	static std::uint32_t tagOf(std::uint64_t word)
+	{
+		return static_cast<std::uint32_t>(word >> 32);
+	}
+
+	static int log2Floor(std::uint32_t v)
+	{
+		int r = 0;
+		if (v >= (1u << 16)) { v >>= 16; r += 16; }
+		if (v >= (1u << 8))  { v >>= 8;  r += 8; }
+		if (v >= (1u << 4))  { v >>= 4;  r += 4; }
+		if (v >= (1u << 2))  { v >>= 2;  r += 2; }
+		if (v >= (1u << 1))  { r += 1; }
+		return r;
+	}
+
+	// ± idx λڵ k 飬 k  kFirstChunkSize * (2^k - 1) ʼ
+	static int chunkOf(std::uint32_t idx)
+	{
+		return log2Floor(idx / kFirstChunkSize + 1);
+	}
+
+	static std::uint32_t chunkBase(int k)
+	{
+		return kFirstChunkSize * ((1u << k) - 1);
+	}
+
+	Node& node(std::uint32_t idx)
+	{
+		int k = chunkOf(idx);
+		return chunks[k].load(std::memory_order_acquire)[idx - chunkBase(k)];
+	}
+
+	std::uint32_t allocNode()
+	{
+		std::uint32_t idx = popIndex(freeList);
+		if (idx != kNull) {
+			return idx;
+		}
+
+		idx = fresh.fetch_add(1, std::memory_order_relaxed);
+		int k = chunkOf(idx);
+		assert(k < kMaxChunks);
+
+		// ߳̿ͬʱĳ黹ڣֻһ̵߳ CAS ɹ߳ͷԼĿ
+		if (chunks[k].load(std::memory_order_acquire) == nullptr) {
+			Node *p = new Node[kFirstChunkSize << k];
+			Node *expected = nullptr;
+			if (!chunks[k].compare_exchange_strong(expected, p, std::memory_order_acq_rel)) {
+				delete[] p;
+			}
+		}
+
+		return idx;
+	}
+
+	void pushIndex(std::atomic<std::uint64_t> &list, std::uint32_t idx)
+	{
+		Node &n = node(idx);
+		std::uint64_t old = list.load(std::memory_order_relaxed);
+		do {
+			n.next.store(indexOf(old), std::memory_order_relaxed);
+		} while (!list.compare_exchange_weak(old, pack(idx, tagOf(old) + 1),
+											 std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	std::uint32_t popIndex(std::atomic<std::uint64_t> &list)
+	{
+		std::uint64_t old = list.load(std::memory_order_acquire);
+		for (;;) {
+			std::uint32_t idx = indexOf(old);
+			if (idx == kNull) {
+				return kNull;
+			}
+
+			//  next ѾڣĻջ tag ȻѾ仯 CAS ʧܲ
+			std::uint32_t next = node(idx).next.load(std::memory_order_relaxed);
+			if (list.compare_exchange_weak(old, pack(next, tagOf(old) + 1),
+										   std::memory_order_acquire, std::memory_order_acquire)) {
+				return idx;
+			}
+		}
+	}
+
+private:
+	std::atomic<std::uint64_t> head;     // ջ{tag, ±}
+	std::atomic<std::uint64_t> freeList; // нڵͬ tag
+	std::atomic<std::uint32_t> fresh;    // δʹùһڵ±
+	std::atomic<Node*> chunks[kMaxChunks];
+};
+
+// ԣÿ߳̽ѹ͵ͳ߳ÿɵĲ
+template<typename S>
+double benchmark(int threads, int opsPerThread)
+{
+	S stack;
+	std::atomic<bool> go(false);
+	std::vector<std::thread> workers;
+
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&stack, &go, opsPerThread, t]() {
+			while (!go.load(std::memory_order_acquire)) {
+			}
+
+			long value = 0;
+			for (int i = 0; i < opsPerThread; i++) {
+				stack.push(static_cast<long>(t) * opsPerThread + i);
+				if ((i & 1) == 1) { // ÿѹ뵯Σջֽǳ
+					stack.try_pop(value);
+					stack.try_pop(value);
+				}
+			}
+		});
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	go.store(true, std::memory_order_release);
+	for (auto &w : workers) {
+		w.join();
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	return 2.0 * threads * opsPerThread / elapsed.count() / 1e6;
+}
+
+int main()
+{
+	ConcurrentStack<std::string> s;
+	s.push("hello ");
+	s.push("world ");
+	s.push(" !");
+
+	std::string str;
+	while (s.try_pop(str)) {
+		std::cout << str << std::endl;
+	}
+
+	const int opsPerThread = 1 << 18;
+	for (int threads = 1; threads <= 16; threads *= 2) {
+		double locked = benchmark<MutexStack<long>>(threads, opsPerThread);
+		double lockFree = benchmark<ConcurrentStack<long>>(threads, opsPerThread);
+		std::cout << "threads = " << threads
+				  << "  mutex Stack: " << locked << " Mops/s"
+				  << "  ConcurrentStack: " << lockFree << " Mops/s" << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,310 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+/* ģӦ--ԭʼ洢ϹԪص StaticStack  SmallStack */
+
+// 8_ģ.cpp е Stack<T, Size> ʹ T s[Size] 洢Ԫأ⣺
+// һջʱĬϹȫ Size ԪأûĬϹ캯͸޷ʹã
+// pop() ֻ nums һԪزûбеԴҪջʱͷţ
+// 취ֻһС붼ʵԭʼڴ棬push ʱ placement new Ԫأpop ʱʽ
+
+template<typename T, std::size_t N>
+class StaticStack
+{
+public:
+	StaticStack() = default;
+
+	StaticStack(const StaticStack &rhs)
+	{
+		for (std::size_t i = 0; i < rhs.nums; i++) {
+			push(rhs[i]);
+		}
+	}
+
+	StaticStack(StaticStack &&rhs)
+	{
+		for (std::size_t i = 0; i < rhs.nums; i++) {
+			push(std::move(*rhs.slot(i)));
+		}
+		rhs.clear();
+	}
+
+	StaticStack& operator=(const StaticStack &rhs)
+	{
+		if (this != &rhs) {
+			clear();
+			for (std::size_t i = 0; i < rhs.nums; i++) {
+				push(rhs[i]);
+			}
+		}
+		return *this;
+	}
+
+	~StaticStack()
+	{
+		clear();
+	}
+
+	void push(const T &elem)
+	{
+		emplace(elem);
+	}
+
+	void push(T &&elem)
+	{
+		emplace(std::move(elem));
+	}
+
+	// ֱԤõĴ洢ϹԪ
+	template<typename... Args>
+	void emplace(Args&&... args)
+	{
+		assert(nums < N);
+
+		new (slot(nums)) T(std::forward<Args>(args)...);
+		nums++;
+	}
+
+	void pop()
+	{
+		assert(!empty());
+
+		nums--;
+		slot(nums)->~T(); // ͬʱԪ
+	}
+
+	const T& top() const
+	{
+		assert(!empty());
+		return *slot(nums - 1);
+	}
+
+	bool empty() const
+	{
+		return nums == 0;
+	}
+
+	bool full() const
+	{
+		return nums == N;
+	}
+
+	std::size_t size() const
+	{
+		return nums;
+	}
+
+	void clear()
+	{
+		while (nums > 0) {
+			pop();
+		}
+	}
+
+	void printStack() const
+	{
+		for (std::size_t i = 0; i < nums; i++) {
+			std::cout << (*this)[i] << std::endl;
+		}
+	}
+
+private:
+	const T& operator[](std::size_t i) const
+	{
+		return *slot(i);
+	}
+
+	T* slot(std::size_t i)
+	{
+		return reinterpret_cast<T*>(&s[i]);
+	}
+
+	const T* slot(std::size_t i) const
+	{
+		return reinterpret_cast<const T*>(&s[i]);
+	}
+
+private:
+	std::size_t nums = 0;
+	// δʼĴ洢ֻдСͶ T ͬ T κι캯
+	typename std::aligned_storage<sizeof(T), alignof(T)>::type s[N];
+};
+
+// SmallStackǰ N Ԫطڶڲͨǵߵջ֡ϣ N ֮ŰѶԪطŵϡ
+// £Ȳ NȫҪڴ棬żֵջҲȻȷ
+template<typename T, std::size_t N>
+class SmallStack
+{
+public:
+	void push(const T &elem)
+	{
+		emplace(elem);
+	}
+
+	void push(T &&elem)
+	{
+		emplace(std::move(elem));
+	}
+
+	template<typename... Args>
+	void emplace(Args&&... args)
+	{
+		if (!inlined.full()) {
+			inlined.emplace(std::forward<Args>(args)...);
+		}
+		else {
+			spilled.emplace_back(std::forward<Args>(args)...);
+		}
+	}
+
+	void pop()
+	{
+		assert(!empty());
+
+		if (!spilled.empty()) {
+			spilled.pop_back();
+		}
+		else {
+			inlined.pop();
+		}
+	}
+
+	const T& top() const
+	{
+		assert(!empty());
+
+		return spilled.empty() ? inlined.top() : spilled.back();
+	}
+
+	bool empty() const
+	{
+		return inlined.empty();
+	}
+
+	std::size_t size() const
+	{
+		return inlined.size() + spilled.size();
+	}
+
+	// ǰǷѾ
+	bool spilledToHeap() const
+	{
+		return !spilled.empty();
+	}
+
+	void printStack() const
+	{
+		inlined.printStack();
+		for (auto &it : spilled) {
+			std::cout << it << std::endl;
+		}
+	}
+
+private:
+	StaticStack<T, N> inlined;
+	std::vector<T> spilled;
+};
+
+// ΪԱȵ 6_ģ.cpp л std::vector  Stackȥ˹캯еĴӡʱᱻ
+template<typename T>
+class Stack
+{
+public:
+	void push(const T &elem)
+	{
+		s.push_back(elem);
+	}
+
+	void pop()
+	{
+		assert(!s.empty());
+
+		s.pop_back();
+	}
+
+	const T& top()
+	{
+		assert(!s.empty());
+
+		return s.back();
+	}
+
+	bool empty() const
+	{
+		return s.empty();
+	}
+
+private:
+	std::vector<T> s;
+};
+
+// ûĬϹ캯ͣ 8_ģ.cpp е Stack<T, Size> StaticStack
+class Token
+{
+public:
+	explicit Token(const std::string &text_) : text(text_)
+	{
+
+	}
+
+	friend std::ostream& operator<<(std::ostream &os, const Token &t)
+	{
+		return os << "Token(" << t.text << ")";
+	}
+
+private:
+	std::string text;
+};
+
+// ԣȵ·ϵʱջÿεö½һջѹ depth Ԫغȫ
+template<typename S>
+double benchmark(int calls, int depth, long long &checksum)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (int c = 0; c < calls; c++) {
+		S scratch;
+		for (int i = 0; i < depth; i++) {
+			scratch.push(c + i);
+		}
+		while (!scratch.empty()) {
+			checksum += scratch.top();
+			scratch.pop();
+		}
+	}
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count();
+}
+
+int main()
+{
+	StaticStack<Token, 4> tokens;
+	tokens.emplace("hello");
+	tokens.push(Token("world"));
+	tokens.printStack();
+	tokens.pop();
+
+	SmallStack<int, 4> small;
+	for (int i = 10; i <= 60; i += 10) {
+		small.push(i);
+	}
+	std::cout << "size = " << small.size() << ", spilled to heap : " << small.spilledToHeap() << std::endl;
+	small.printStack();
+
+	const int calls = 1000000;
+	const int depth = 16;
+	long long checksum = 0; // ۼԼ 3.2e13Windows ϵ long ֻ 32 λ
+	std::cout << "Stack<int>            : " << benchmark<Stack<int>>(calls, depth, checksum) << " ms" << std::endl;
+	std::cout << "StaticStack<int, 32>  : " << benchmark<StaticStack<int, 32>>(calls, depth, checksum) << " ms" << std::endl;
+	std::cout << "SmallStack<int, 32>   : " << benchmark<SmallStack<int, 32>>(calls, depth, checksum) << " ms" << std::endl;
+	std::cout << "SmallStack<int, 8>    : " << benchmark<SmallStack<int, 8>>(calls, depth, checksum) << " ms (spills)" << std::endl;
+	std::cout << "checksum = " << checksum << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,162 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+/* ģӦ--ͳ push(const T&)push(T&&)emplace() Լ pop_value() Բڴ */
+
+// 滻ȫֵ operator new/deleteͳƳڼһ˶ٴڴ
+static long g_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+	g_allocations++;
+	if (void *p = std::malloc(size ? size : 1)) {
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+//  6_ģ.cpp ͬ Stackȥ˹캯еĴӡ
+template<typename T>
+class Stack
+{
+public:
+	void push(const T &elem)
+	{
+		s.push_back(elem);
+	}
+
+	void push(T &&elem) noexcept(noexcept(std::declval<std::vector<T>&>().push_back(std::move(elem))))
+	{
+		s.push_back(std::move(elem));
+	}
+
+	template<typename... Args>
+	void emplace(Args&&... args) noexcept(noexcept(std::declval<std::vector<T>&>().emplace_back(std::forward<Args>(args)...)))
+	{
+		s.emplace_back(std::forward<Args>(args)...);
+	}
+
+	void pop()
+	{
+		assert(!s.empty());
+
+		s.pop_back();
+	}
+
+	T pop_value() noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		assert(!s.empty());
+
+		T elem(std::move(s.back()));
+		s.pop_back();
+		return elem;
+	}
+
+	const T& top()
+	{
+		assert(!s.empty());
+
+		return s.back();
+	}
+
+	bool empty() const
+	{
+		return s.empty();
+	}
+
+private:
+	std::vector<T> s;
+};
+
+// һβԣ fӡʱԼƽÿԪطڴĴ
+template<typename F>
+void measure(const char *name, int count, F f)
+{
+	long before = g_allocations;
+	auto start = std::chrono::steady_clock::now();
+	f();
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::cout << name << " : " << elapsed.count() << " ms, "
+			  << static_cast<double>(g_allocations - before) / count << " allocations per element" << std::endl;
+}
+
+// ֱÿƶԭعѹ count Ԫأٷֱ top()+pop()  pop_value() ȫȡ
+template<typename T, typename Make, typename... EmplaceArgs>
+void benchmark(const char *title, int count, Make make, EmplaceArgs... emplaceArgs)
+{
+	std::cout << "------------ " << title << " ------------" << std::endl;
+	std::size_t checksum = 0;
+
+	Stack<T> copied;
+	measure("push(const T&)  ", count, [&]() {
+		for (int i = 0; i < count; i++) {
+			T elem = make(i);
+			copied.push(elem); // elem ջеԪظһݻ
+		}
+	});
+
+	Stack<T> moved;
+	measure("push(T&&)       ", count, [&]() {
+		for (int i = 0; i < count; i++) {
+			moved.push(make(i)); // ƶֻʱһݻ
+		}
+	});
+
+	Stack<T> emplaced;
+	measure("emplace(args...)", count, [&]() {
+		for (int i = 0; i < count; i++) {
+			emplaced.emplace(emplaceArgs...); // ֱ vector й
+		}
+	});
+
+	measure("top() + pop()   ", count, [&]() {
+		while (!copied.empty()) {
+			T elem = copied.top(); // ٵ
+			copied.pop();
+			checksum += elem.size();
+		}
+	});
+
+	measure("pop_value()     ", count, [&]() {
+		while (!moved.empty()) {
+			T elem = moved.pop_value();
+			checksum += elem.size();
+		}
+	});
+
+	std::cout << "checksum = " << checksum << std::endl;
+}
+
+int main()
+{
+	const int count = 200000;
+
+	// 64 ַ std::string ĶַŻSSOȣÿַҪڶϷ
+	benchmark<std::string>("std::string (64 chars)", count,
+		[](int i) { return std::string(64, static_cast<char>('a' + i % 26)); },
+		std::size_t(64), 'x');
+
+	benchmark<std::vector<char>>("std::vector<char> (4 KB)", count / 10,
+		[](int i) { return std::vector<char>(4096, static_cast<char>(i)); },
+		std::size_t(4096), 'x');
+
+	return 0;
+}
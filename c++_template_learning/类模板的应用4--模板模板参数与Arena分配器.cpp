@@ -0,0 +1,377 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+/* ģӦ--ģģ Stack  Alloc ṩ arenaڴ */
+
+// 16_ģģ.cpp е Stack ѵģ Allocator  Alloc ȥ˹캯еĴӡ
+template<typename T,
+template<typename Elem, typename Alloc = std::allocator<Elem>> class Container = std::vector,
+typename Allocator = std::allocator<T>>
+class Stack
+{
+public:
+	explicit Stack(const Allocator &alloc = Allocator()) : s(alloc)
+	{
+
+	}
+
+	void push(const T &elem)
+	{
+		s.push_back(elem);
+	}
+
+	void pop()
+	{
+		assert(!s.empty());
+
+		s.pop_back();
+	}
+
+	const T& top()
+	{
+		assert(!s.empty());
+
+		return s.back();
+	}
+
+	bool empty() const
+	{
+		return s.empty();
+	}
+
+private:
+	Container<T, Allocator> s;
+};
+
+// monotonic arenaֻǰƶָڴ棬 deallocate ʲôҲ
+// ڴ reset() ʱһԡͷšreset() ֻǰָ벦صһ飬ѾĿᱻظʹã
+// һʱͷ Stack ֻҪ O(1) ʱ䡣
+class MonotonicArena
+{
+	struct Block
+	{
+		Block *next;
+		std::size_t size; // ֽ Block ͷ֮
+	};
+
+	static constexpr std::size_t kHeader = (sizeof(Block) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+public:
+	explicit MonotonicArena(std::size_t initialSize = 64 * 1024)
+	{
+		head = current = newBlock(initialSize);
+		ptr = dataOf(current);
+	}
+
+	MonotonicArena(const MonotonicArena&) = delete;
+	MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+	~MonotonicArena()
+	{
+		while (head != nullptr) {
+			Block *next = head->next;
+			::operator delete(head);
+			head = next;
+		}
+	}
+
+	void* allocate(std::size_t bytes, std::size_t align)
+	{
+		for (;;) {
+			char *p = alignUp(ptr, align);
+			if (p + bytes <= dataOf(current) + current->size) {
+				ptr = p + bytes;
+				return p;
+			}
+
+			// ǰ鲻ãȿ reset() ֮ǰһ飬Ļһ¿ں
+			if (current->next == nullptr || current->next->size < bytes + align) {
+				std::size_t size = current->size * 2;
+				if (size < bytes + align) {
+					size = bytes + align;
+				}
+
+				Block *b = newBlock(size);
+				b->next = current->next;
+				current->next = b;
+			}
+
+			current = current->next;
+			ptr = dataOf(current);
+		}
+	}
+
+	void deallocate(void *, std::size_t, std::size_t)
+	{
+		// յ
+	}
+
+	void reset()
+	{
+		current = head;
+		ptr = dataOf(current);
+	}
+
+private:
+	static Block* newBlock(std::size_t size)
+	{
+		Block *b = static_cast<Block*>(::operator new(kHeader + size));
+		b->next = nullptr;
+		b->size = size;
+		return b;
+	}
+
+	static char* dataOf(Block *b)
+	{
+		return reinterpret_cast<char*>(b) + kHeader;
+	}
+
+	static char* alignUp(char *p, std::size_t align)
+	{
+		std::uintptr_t v = reinterpret_cast<std::uintptr_t>(p);
+		return reinterpret_cast<char*>((v + align - 1) & ~static_cast<std::uintptr_t>(align - 1));
+	}
+
+private:
+	Block *head;
+	Block *current;
+	char *ptr;
+};
+
+// ̰߳ȫڴأ 2 ݻִСȼÿȼһ
+// ͷŵڴһضӦĿ֮ͬСķֱӸãپ malloc
+// Ϊʱε MonotonicArena һгһȼķֱӽ operator new
+class PoolResource
+{
+	struct FreeNode
+	{
+		FreeNode *next;
+	};
+
+	static constexpr std::size_t kMinShift = 4;  // С 16 ֽ
+	static constexpr std::size_t kClasses = 9;   // 16 ֽ ... 4 KB
+	static constexpr std::size_t kBatch = 32;    // ÿβ 32 
+
+public:
+	PoolResource()
+	{
+		for (std::size_t i = 0; i < kClasses; i++) {
+			freeLists[i] = nullptr;
+		}
+	}
+
+	PoolResource(const PoolResource&) = delete;
+	PoolResource& operator=(const PoolResource&) = delete;
+
+	void* allocate(std::size_t bytes, std::size_t align)
+	{
+		std::size_t c = classOf(bytes);
+		if (c >= kClasses || align > alignof(std::max_align_t)) {
+			return ::operator new(bytes);
+		}
+
+		if (freeLists[c] == nullptr) {
+			refill(c);
+		}
+
+		FreeNode *n = freeLists[c];
+		freeLists[c] = n->next;
+		return n;
+	}
+
+	void deallocate(void *p, std::size_t bytes, std::size_t align)
+	{
+		std::size_t c = classOf(bytes);
+		if (c >= kClasses || align > alignof(std::max_align_t)) {
+			::operator delete(p);
+			return;
+		}
+
+		FreeNode *n = static_cast<FreeNode*>(p);
+		n->next = freeLists[c];
+		freeLists[c] = n;
+	}
+
+	// ڴ涼Σ֮ǰȥָȫʧЧ
+	void release()
+	{
+		for (std::size_t i = 0; i < kClasses; i++) {
+			freeLists[i] = nullptr;
+		}
+		upstream.reset();
+	}
+
+private:
+	static std::size_t classOf(std::size_t bytes)
+	{
+		std::size_t c = 0;
+		while ((std::size_t(1) << (c + kMinShift)) < bytes) {
+			c++;
+		}
+		return c;
+	}
+
+	void refill(std::size_t c)
+	{
+		std::size_t size = std::size_t(1) << (c + kMinShift);
+		char *p = static_cast<char*>(upstream.allocate(size * kBatch, alignof(std::max_align_t)));
+		for (std::size_t i = 0; i < kBatch; i++) {
+			deallocate(p + i * size, size, alignof(std::max_align_t));
+		}
+	}
+
+private:
+	FreeNode *freeLists[kClasses];
+	MonotonicArena upstream;
+};
+
+// ֡ڴԴɱ׼ʹõķC++17  std::pmr ͬ˼·
+// ֻһָԴָ룬ܱˣrebind ֮ȻָͬһԴ
+template<typename T, typename Resource>
+class ResourceAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ResourceAllocator(Resource &r) : res(&r)
+	{
+
+	}
+
+	template<typename U>
+	ResourceAllocator(const ResourceAllocator<U, Resource> &other) : res(other.resource())
+	{
+
+	}
+
+	T* allocate(std::size_t n)
+	{
+		return static_cast<T*>(res->allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T *p, std::size_t n)
+	{
+		res->deallocate(p, n * sizeof(T), alignof(T));
+	}
+
+	Resource* resource() const
+	{
+		return res;
+	}
+
+	template<typename U>
+	bool operator==(const ResourceAllocator<U, Resource> &other) const
+	{
+		return res == other.resource();
+	}
+
+	template<typename U>
+	bool operator!=(const ResourceAllocator<U, Resource> &other) const
+	{
+		return res != other.resource();
+	}
+
+private:
+	Resource *res;
+};
+
+template<typename T>
+using ArenaAllocator = ResourceAllocator<T, MonotonicArena>;
+
+template<typename T>
+using PoolAllocator = ResourceAllocator<T, PoolResource>;
+
+// ģ壬ʹ arena  Stack дͨ Stack һ
+template<typename T, template<typename, typename> class Container = std::vector>
+using ArenaStack = Stack<T, Container, ArenaAllocator<T>>;
+
+template<typename T, template<typename, typename> class Container = std::vector>
+using PoolStack = Stack<T, Container, PoolAllocator<T>>;
+
+// ģһ󣺴 stacksPerRequest  StackÿѹԪأʱȫ
+template<typename S, typename Alloc>
+long handleRequest(const Alloc &alloc, int stacksPerRequest, int request)
+{
+	long checksum = 0;
+	std::vector<S> stacks;
+	stacks.reserve(stacksPerRequest);
+
+	for (int i = 0; i < stacksPerRequest; i++) {
+		stacks.emplace_back(alloc);
+		int depth = 8 + (request * 7 + i * 13) % 120;
+		for (int j = 0; j < depth; j++) {
+			stacks.back().push(j);
+		}
+		checksum += stacks.back().top();
+	}
+
+	return checksum;
+}
+
+template<typename F>
+double measure(F f)
+{
+	auto start = std::chrono::steady_clock::now();
+	f();
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count();
+}
+
+int main()
+{
+	MonotonicArena arena;
+	{
+		ArenaStack<int> s{ ArenaAllocator<int>(arena) };
+		for (int i = 0; i < 10; i++) {
+			s.push(i);
+		}
+		std::cout << "top = " << s.top() << std::endl;
+
+		PoolResource pool;
+		PoolStack<double, std::deque> d{ PoolAllocator<double>(pool) };
+		d.push(1.5);
+		std::cout << "top = " << d.top() << std::endl;
+	}
+	arena.reset();
+
+	const int requests = 20000;
+	const int stacksPerRequest = 64;
+	long checksum = 0;
+
+	double mallocMs = measure([&]() {
+		std::allocator<int> alloc;
+		for (int r = 0; r < requests; r++) {
+			checksum += handleRequest<Stack<int>>(alloc, stacksPerRequest, r);
+		}
+	});
+
+	double poolMs = measure([&]() {
+		PoolResource pool;
+		PoolAllocator<int> alloc(pool);
+		for (int r = 0; r < requests; r++) {
+			checksum += handleRequest<PoolStack<int>>(alloc, stacksPerRequest, r);
+		}
+	});
+
+	double arenaMs = measure([&]() {
+		ArenaAllocator<int> alloc(arena);
+		for (int r = 0; r < requests; r++) {
+			checksum += handleRequest<ArenaStack<int>>(alloc, stacksPerRequest, r);
+			arena.reset(); // O(1) ͷȫڴ
+		}
+	});
+
+	std::cout << "std::allocator (malloc) : " << mallocMs << " ms" << std::endl;
+	std::cout << "PoolResource            : " << poolMs << " ms" << std::endl;
+	std::cout << "MonotonicArena + reset  : " << arenaMs << " ms" << std::endl;
+	std::cout << "checksum = " << checksum << std::endl;
+
+	return 0;
+}
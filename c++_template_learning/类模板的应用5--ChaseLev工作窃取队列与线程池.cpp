@@ -0,0 +1,481 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <cassert>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/* ģӦ--Chase-Lev ȡ˫˶УԼĹ̶С̳߳ */
+
+// 7_ģĬϲͱԼģ.cpp е Stack ͱģ DequeStack
+template<typename T, typename Container = std::vector<T>>
+class Stack
+{
+public:
+	Stack()
+	{
+		std::cout << "-------------- Template Stack ------------" << std::endl;
+	}
+
+	void push(const T &elem)
+	{
+		s.push_back(elem);
+	}
+
+	void pop()
+	{
+		assert(!s.empty());
+
+		s.pop_back();
+	}
+
+	const T& top()
+	{
+		assert(!s.empty());
+
+		return s.back();
+	}
+
+	bool empty() const
+	{
+		return s.empty();
+	}
+
+private:
+	Container s;
+};
+
+template<typename T>
+using DequeStack = Stack<T, std::deque<T>>;
+
+// DequeStack ֻһˣջֻܱһ߳ʹá
+// ȡͬһ˫˶Уӵ̣߳ownerڵײbottompush/popջһǺȳ
+// ̣߳thiefӶtopȡŽȥԪءڵݹε
+// Žȥ⣬һȡߺܶ๤ owner ǴողֳڻеС⡣
+//
+// ʵֲο Chase & Lev2005Լ L ˸ C11 ڴģͰ汾2013
+// Ҫһpush  pop ֻ owner ãֻ pop  steal һԪʱҪ CAS
+// ҪԺΪ鲻ͷţthief ܻڶȵʱͳһͷţ
+// ҪԪԭӱţ T ǿƽģָͨ룩
+template<typename T>
+class WorkStealingDeque
+{
+	static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque requires a trivially copyable T");
+
+	class Array
+	{
+	public:
+		explicit Array(std::int64_t capacity_) : capacity(capacity_), mask(capacity_ - 1), slots(new std::atomic<T>[capacity_])
+		{
+
+		}
+
+		std::int64_t size() const
+		{
+			return capacity;
+		}
+
+		T get(std::int64_t i) const
+		{
+			return slots[i & mask].load(std::memory_order_relaxed);
+		}
+
+		void put(std::int64_t i, T x)
+		{
+			slots[i & mask].store(x, std::memory_order_relaxed);
+		}
+
+		Array* grow(std::int64_t bottom, std::int64_t top) const
+		{
+			Array *a = new Array(capacity * 2);
+			for (std::int64_t i = top; i != bottom; i++) {
+				a->put(i, get(i));
+			}
+			return a;
+		}
+
+	private:
+		std::int64_t capacity; //  2 
+		std::int64_t mask;
+		std::unique_ptr<std::atomic<T>[]> slots;
+	};
+
+public:
+	explicit WorkStealingDeque(std::int64_t capacity = 1024) : top(0), bottom(0), array(new Array(capacity))
+	{
+		assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+		retired.emplace_back(array.load(std::memory_order_relaxed));
+	}
+
+	WorkStealingDeque(const WorkStealingDeque&) = delete;
+	WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+	// ֻ owner 
+	void push(T x)
+	{
+		std::int64_t b = bottom.load(std::memory_order_relaxed);
+		std::int64_t t = top.load(std::memory_order_acquire);
+		Array *a = array.load(std::memory_order_relaxed);
+
+		if (b - t > a->size() - 1) {
+			a = a->grow(b, t);
+			retired.emplace_back(a);
+			array.store(a, std::memory_order_release);
+		}
+
+		a->put(b, x);
+		bottom.store(b + 1, std::memory_order_release); //  steal() ж bottom  acquire 
+	}
+
+	// ֻ owner ãӵײΪʱ false
+	bool pop(T &out)
+	{
+		std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		Array *a = array.load(std::memory_order_relaxed);
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::int64_t t = top.load(std::memory_order_relaxed);
+
+		if (t > b) { // бǿյ
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		out = a->get(b);
+		if (t == b) {
+			// ֻʣһԪأ thief ˭ CAS ɹ˭
+			bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return won;
+		}
+
+		return true;
+	}
+
+	// κ̶߳ԵãӶȡΪջ߾ʧʱ false
+	bool steal(T &out)
+	{
+		std::int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::int64_t b = bottom.load(std::memory_order_acquire);
+
+		if (t >= b) {
+			return false;
+		}
+
+		Array *a = array.load(std::memory_order_acquire);
+		T x = a->get(t);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return false;
+		}
+
+		out = x;
+		return true;
+	}
+
+	bool empty() const
+	{
+		std::int64_t b = bottom.load(std::memory_order_relaxed);
+		std::int64_t t = top.load(std::memory_order_relaxed);
+		return b <= t;
+	}
+
+private:
+	std::atomic<std::int64_t> top;
+	std::atomic<std::int64_t> bottom;
+	std::atomic<Array*> array;
+	std::vector<std::unique_ptr<Array>> retired; // ù飬ֻ owner ޸
+};
+
+// һspawn ʱһִһwait() ȵ
+class TaskGroup
+{
+public:
+	TaskGroup() : pending(0)
+	{
+
+	}
+
+	std::atomic<int> pending;
+};
+
+// ̶С̳߳أÿ߳ӵһ WorkStealingDeque
+// ԼŽԼĶУԼĶп˾һ߳ȥȡ
+// ߳ύŽһעУ·ȵ㣩
+class ThreadPool
+{
+	struct Task
+	{
+		std::function<void()> fn;
+		TaskGroup *group;
+	};
+
+public:
+	explicit ThreadPool(unsigned threads) : stop(false)
+	{
+		assert(threads > 0);
+
+		for (unsigned i = 0; i < threads; i++) {
+			queues.emplace_back(new WorkStealingDeque<Task*>());
+		}
+		for (unsigned i = 0; i < threads; i++) {
+			workers.emplace_back([this, i]() { workerLoop(i); });
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	~ThreadPool()
+	{
+		stop.store(true, std::memory_order_release);
+		for (auto &w : workers) {
+			w.join();
+		}
+	}
+
+	// queues ֮߳ǰѾã֮޸ģ߳̿Էĵضȡ
+	unsigned size() const
+	{
+		return static_cast<unsigned>(queues.size());
+	}
+
+	template<typename F>
+	void spawn(TaskGroup &group, F &&f)
+	{
+		group.pending.fetch_add(1, std::memory_order_relaxed);
+		Task *task = new Task{ std::function<void()>(std::forward<F>(f)), &group };
+
+		int self = workerIndex(this);
+		if (self >= 0) {
+			queues[self]->push(task);
+		}
+		else {
+			std::lock_guard<std::mutex> lock(injectMutex);
+			injected.push_back(task);
+		}
+	}
+
+	// ȴһɣȴͬʱæִݹ spawn/wait ̶߳ס
+	void wait(TaskGroup &group)
+	{
+		int self = workerIndex(this);
+		while (group.pending.load(std::memory_order_acquire) != 0) {
+			if (!runOne(self)) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+private:
+	// ÿ̼߳¼Լĸ̳߳صĵڼ߳
+	static int& workerIndexSlot()
+	{
+		static thread_local int index = -1;
+		return index;
+	}
+
+	static ThreadPool*& workerPoolSlot()
+	{
+		static thread_local ThreadPool *pool = nullptr;
+		return pool;
+	}
+
+	static int workerIndex(const ThreadPool *pool)
+	{
+		return workerPoolSlot() == pool ? workerIndexSlot() : -1;
+	}
+
+	void workerLoop(unsigned index)
+	{
+		workerPoolSlot() = this;
+		workerIndexSlot() = static_cast<int>(index);
+
+		int idle = 0;
+		while (!stop.load(std::memory_order_acquire)) {
+			if (runOne(static_cast<int>(index))) {
+				idle = 0;
+			}
+			else if (++idle < 64) {
+				std::this_thread::yield();
+			}
+			else {
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+			}
+		}
+	}
+
+	bool runOne(int self)
+	{
+		Task *task = nullptr;
+		if ((self >= 0 && queues[self]->pop(task)) || takeInjected(task) || stealOne(self, task)) {
+			task->fn();
+			task->group->pending.fetch_sub(1, std::memory_order_release);
+			delete task;
+			return true;
+		}
+		return false;
+	}
+
+	bool takeInjected(Task *&task)
+	{
+		std::lock_guard<std::mutex> lock(injectMutex);
+		if (injected.empty()) {
+			return false;
+		}
+
+		task = injected.front();
+		injected.pop_front();
+		return true;
+	}
+
+	bool stealOne(int self, Task *&task)
+	{
+		static thread_local std::uint32_t seed = 2463534242u;
+		unsigned n = size();
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+
+		unsigned start = seed % n;
+		for (unsigned i = 0; i < n; i++) {
+			unsigned victim = (start + i) % n;
+			if (static_cast<int>(victim) != self && queues[victim]->steal(task)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	std::vector<std::unique_ptr<WorkStealingDeque<Task*>>> queues;
+	std::vector<std::thread> workers;
+	std::atomic<bool> stop;
+
+	std::mutex injectMutex;
+	std::deque<Task*> injected;
+};
+
+// ȡʵ3--ȡ.cpp е AccumulateTrait  accumֻг int
+template<typename T>
+struct AccumulateTrait;
+
+template<>
+struct AccumulateTrait<int>
+{
+	using AccT = long;
+	static constexpr AccT zero()
+	{
+		return 0;
+	}
+};
+
+template<typename T, typename AT = AccumulateTrait<T>>
+auto accum(T const* beg, T const* end)
+{
+	typename AT::AccT total = AT::zero();
+
+	while (beg != end) {
+		total += *beg;
+		++beg;
+	}
+
+	return total;
+}
+
+// ̵߳ķΣ DequeStack 滹ûд
+template<typename T, typename AT = AccumulateTrait<T>>
+typename AT::AccT serialAccum(T const* beg, T const* end, std::ptrdiff_t grain)
+{
+	struct Range
+	{
+		T const* beg;
+		T const* end;
+	};
+
+	typename AT::AccT total = AT::zero();
+	DequeStack<Range> pending;
+	pending.push(Range{ beg, end });
+
+	while (!pending.empty()) {
+		Range r = pending.top();
+		pending.pop();
+
+		if (r.end - r.beg <= grain) {
+			total += accum<T, AT>(r.beg, r.end);
+		}
+		else {
+			T const* mid = r.beg + (r.end - r.beg) / 2;
+			pending.push(Range{ mid, r.end });
+			pending.push(Range{ r.beg, mid });
+		}
+	}
+
+	return total;
+}
+
+// ̵߳ķΣΪŽǰ̵߳ĶУܱ߳͵ߣҰԼŵݹ
+template<typename T, typename AT = AccumulateTrait<T>>
+typename AT::AccT parallelAccum(ThreadPool &pool, T const* beg, T const* end, std::ptrdiff_t grain)
+{
+	if (end - beg <= grain) {
+		return accum<T, AT>(beg, end);
+	}
+
+	T const* mid = beg + (end - beg) / 2;
+	typename AT::AccT left = AT::zero();
+
+	TaskGroup group;
+	pool.spawn(group, [&pool, &left, beg, mid, grain]() {
+		left = parallelAccum<T, AT>(pool, beg, mid, grain);
+	});
+	typename AT::AccT right = parallelAccum<T, AT>(pool, mid, end, grain);
+	pool.wait(group);
+
+	return left + right;
+}
+
+int main()
+{
+	const std::size_t n = 1 << 26;
+	const std::ptrdiff_t grain = 1 << 16;
+	std::vector<int> data(n);
+	for (std::size_t i = 0; i < n; i++) {
+		data[i] = static_cast<int>(i % 10);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	long expected = serialAccum(data.data(), data.data() + n, grain);
+	std::chrono::duration<double, std::milli> serialMs = std::chrono::steady_clock::now() - start;
+	std::cout << "serial (DequeStack) : " << serialMs.count() << " ms, sum = " << expected << std::endl;
+
+	unsigned maxThreads = std::thread::hardware_concurrency();
+	if (maxThreads == 0) {
+		maxThreads = 4;
+	}
+
+	for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+		ThreadPool pool(threads);
+		long sum = 0;
+
+		start = std::chrono::steady_clock::now();
+		TaskGroup group;
+		pool.spawn(group, [&]() {
+			sum = parallelAccum(pool, data.data(), data.data() + n, grain);
+		});
+		pool.wait(group);
+		std::chrono::duration<double, std::milli> ms = std::chrono::steady_clock::now() - start;
+
+		std::cout << "threads = " << threads << " : " << ms.count() << " ms, speedup = "
+				  << serialMs.count() / ms.count() << (sum == expected ? "" : "  (WRONG RESULT)") << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,345 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/* ģӦ--Ԥһַռ䡢ύҳʱӲԪص */
+
+// 7_ģĬϲͱԼģ.cpp е Stack<T, Container>
+// һ shrink_to_fit()תstd::vector ҲͬĳԱ
+template<typename T, typename Container = std::vector<T>>
+class Stack
+{
+	using Iterator = typename Container::iterator;
+
+public:
+	Stack()
+	{
+		std::cout << "-------------- Template Stack ------------" << std::endl;
+	}
+
+	void push(const T &elem)
+	{
+		s.push_back(elem);
+	}
+
+	void pop()
+	{
+		assert(!s.empty());
+
+		s.pop_back();
+	}
+
+	const T& top()
+	{
+		assert(!s.empty());
+
+		return s.back();
+	}
+
+	bool empty() const
+	{
+		return s.empty();
+	}
+
+	void shrink_to_fit()
+	{
+		s.shrink_to_fit();
+	}
+
+	void printStack() const
+	{
+		for (auto it : s) {
+			std::cout << it << std::endl;
+		}
+	}
+
+private:
+	Container s;
+};
+
+// ڴļԤֻռַռ䣬ռڴ棩ύΪɶд黹ͷҳַռȻ
+namespace vm
+{
+	inline std::size_t pageSize()
+	{
+#ifdef _WIN32
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		return info.dwPageSize;
+#else
+		return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+	}
+
+	inline void* reserve(std::size_t bytes)
+	{
+#ifdef _WIN32
+		void *p = VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS);
+		if (p == nullptr) {
+			throw std::bad_alloc();
+		}
+#else
+		void *p = mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if (p == MAP_FAILED) {
+			throw std::bad_alloc();
+		}
+#endif
+		return p;
+	}
+
+	inline void commit(void *p, std::size_t bytes)
+	{
+#ifdef _WIN32
+		if (VirtualAlloc(p, bytes, MEM_COMMIT, PAGE_READWRITE) == nullptr) {
+			throw std::bad_alloc();
+		}
+#else
+		if (mprotect(p, bytes, PROT_READ | PROT_WRITE) != 0) {
+			throw std::bad_alloc();
+		}
+#endif
+	}
+
+	inline void decommit(void *p, std::size_t bytes)
+	{
+#ifdef _WIN32
+		VirtualFree(p, bytes, MEM_DECOMMIT);
+#else
+		madvise(p, bytes, MADV_DONTNEED); // ҳϵͳٴηʱȫ 0 ҳ
+		mprotect(p, bytes, PROT_NONE);
+#endif
+	}
+
+	inline void release(void *p, std::size_t bytes)
+	{
+#ifdef _WIN32
+		(void)bytes;
+		VirtualFree(p, 0, MEM_RELEASE);
+#else
+		munmap(p, bytes);
+#endif
+	}
+}
+
+// VirtualVectorʱһԤ reservedBytes ֽڵĵַռ䣨64 λĬ 64 GBֻռַռڴ棩
+// ԪʱֻǰѺҳύΪɶдеԪԶᱻƶ򿽱ָǵָҲһֱЧ
+// Ϊ Stack  Container ʹãStack<T, VirtualVector<T>>
+template<typename T>
+class VirtualVector
+{
+public:
+	using value_type = T;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	static constexpr std::size_t kDefaultReserveBytes = std::size_t(1) << (sizeof(void*) == 8 ? 36 : 28); // 64 GB / 256 MB
+	static constexpr std::size_t kCommitChunk = std::size_t(1) << 20; // ÿύ 1 MB
+
+	explicit VirtualVector(std::size_t reservedBytes = kDefaultReserveBytes)
+		: page(vm::pageSize()), reserved(roundUp(reservedBytes, vm::pageSize())), committed(0), count(0)
+	{
+		base = static_cast<T*>(vm::reserve(reserved));
+	}
+
+	VirtualVector(const VirtualVector&) = delete;
+	VirtualVector& operator=(const VirtualVector&) = delete;
+
+	~VirtualVector()
+	{
+		clear();
+		vm::release(base, reserved);
+	}
+
+	void push_back(const T &elem)
+	{
+		emplace_back(elem);
+	}
+
+	void push_back(T &&elem)
+	{
+		emplace_back(std::move(elem));
+	}
+
+	template<typename... Args>
+	T& emplace_back(Args&&... args)
+	{
+		std::size_t need = (count + 1) * sizeof(T);
+		if (need > committed) {
+			grow(need);
+		}
+
+		T *p = new (base + count) T(std::forward<Args>(args)...);
+		count++;
+		return *p;
+	}
+
+	void pop_back()
+	{
+		assert(count > 0);
+
+		count--;
+		base[count].~T();
+	}
+
+	T& back()
+	{
+		assert(count > 0);
+		return base[count - 1];
+	}
+
+	const T& back() const
+	{
+		assert(count > 0);
+		return base[count - 1];
+	}
+
+	T& operator[](std::size_t i)
+	{
+		return base[i];
+	}
+
+	bool empty() const
+	{
+		return count == 0;
+	}
+
+	std::size_t size() const
+	{
+		return count;
+	}
+
+	// Ѿύռڴ棩ֽ
+	std::size_t committed_bytes() const
+	{
+		return committed;
+	}
+
+	void clear()
+	{
+		while (count > 0) {
+			pop_back();
+		}
+	}
+
+	// ջˮλڱǳˣѵǰԪ֮ύҳȫϵͳ
+	void shrink_to_fit()
+	{
+		std::size_t keep = roundUp(count * sizeof(T), page);
+		if (keep < committed) {
+			vm::decommit(reinterpret_cast<char*>(base) + keep, committed - keep);
+			committed = keep;
+		}
+	}
+
+	iterator begin() { return base; }
+	iterator end() { return base + count; }
+	const_iterator begin() const { return base; }
+	const_iterator end() const { return base + count; }
+
+private:
+	static std::size_t roundUp(std::size_t n, std::size_t unit)
+	{
+		return (n + unit - 1) / unit * unit;
+	}
+
+	void grow(std::size_t need)
+	{
+		std::size_t target = roundUp(need, kCommitChunk);
+		if (target > reserved) {
+			target = roundUp(need, page);
+			if (target > reserved) {
+				throw std::bad_alloc(); // Ԥĵַռ
+			}
+		}
+
+		vm::commit(reinterpret_cast<char*>(base) + committed, target - committed);
+		committed = target;
+	}
+
+private:
+	T *base;
+	std::size_t page;
+	std::size_t reserved;
+	std::size_t committed;
+	std::size_t count;
+};
+
+// ѹ n Ԫأÿ 4096 ѹһʱӡܺʱһĺʱ
+template<typename S>
+void benchmark(const char *name, S &s, std::size_t n)
+{
+	const std::size_t batch = 4096;
+	double worst = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	auto last = start;
+	for (std::size_t i = 0; i < n; i++) {
+		s.push(static_cast<long long>(i));
+		if (i % batch == batch - 1) {
+			auto now = std::chrono::steady_clock::now();
+			std::chrono::duration<double, std::milli> ms = now - last;
+			if (ms.count() > worst) {
+				worst = ms.count();
+			}
+			last = now;
+		}
+	}
+	std::chrono::duration<double, std::milli> total = std::chrono::steady_clock::now() - start;
+
+	std::cout << name << " : total " << total.count() << " ms, worst batch of " << batch
+			  << " pushes " << worst << " ms" << std::endl;
+}
+
+int main()
+{
+	Stack<int, VirtualVector<int>> s;
+	for (int i = 0; i < 10; i++) {
+		s.push(i);
+	}
+	s.printStack();
+
+	// ֮ȻЧ
+	VirtualVector<int> v;
+	v.push_back(42);
+	const int *first = &v[0];
+	for (int i = 0; i < 10000000; i++) {
+		v.push_back(i);
+	}
+	std::cout << "first element still at the same address : " << (first == &v[0]) << ", value = " << *first << std::endl;
+
+	// ˮλ֮黹ҳ
+	std::cout << "committed before shrink : " << v.committed_bytes() / (1 << 20) << " MB" << std::endl;
+	while (v.size() > 1000) {
+		v.pop_back();
+	}
+	v.shrink_to_fit();
+	std::cout << "committed after shrink  : " << v.committed_bytes() / 1024 << " KB" << std::endl;
+
+	// ѹ 3200  long long256 MBstd::vector ÿݶҪȫԪأһݷʱ
+	const std::size_t n = std::size_t(1) << 25;
+	{
+		Stack<long long> vec;
+		benchmark("Stack<long long, std::vector>   ", vec, n);
+	}
+	{
+		Stack<long long, VirtualVector<long long>> virt;
+		benchmark("Stack<long long, VirtualVector> ", virt, n);
+	}
+
+	return 0;
+}
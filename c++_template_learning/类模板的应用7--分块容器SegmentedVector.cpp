@@ -0,0 +1,375 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <iterator>
+#include <utility>
+
+/* ģӦ--Сáտոõķֿ SegmentedVector */
+
+// 7_ģĬϲͱԼģ.cpp е Stack<T, Container>
+template<typename T, typename Container = std::vector<T>>
+class Stack
+{
+	using Iterator = typename Container::iterator;
+
+public:
+	Stack()
+	{
+		std::cout << "-------------- Template Stack ------------" << std::endl;
+	}
+
+	void push(const T &elem)
+	{
+		s.push_back(elem);
+	}
+
+	void pop()
+	{
+		assert(!s.empty());
+
+		s.pop_back();
+	}
+
+	const T& top()
+	{
+		assert(!s.empty());
+
+		return s.back();
+	}
+
+	bool empty() const
+	{
+		return s.empty();
+	}
+
+	void printStack() const
+	{
+		for (auto it : s) {
+			std::cout << it << std::endl;
+		}
+	}
+
+private:
+	Container s;
+};
+
+// std::deque ҲǷֿ洢ģ libstdc++ ÿֻ 512 ֽڣҿһվͻᱻͷţ
+// ջĳı߽總ʱÿһζҪ new/delete һ顣
+// SegmentedVector 
+// ҪһĴСģ BlockBytes ָÿԷ BlockBytes / sizeof(T) Ԫأ
+// ҪյĿ鲻ͷţǷŽ´Ҫ¿ʱȸã
+// ҪԪһŽĳͲƶúָʼЧ
+// ҪģʱһڲָֻпʱŲһ顣
+template<typename T, std::size_t BlockBytes = 64 * 1024>
+class SegmentedVector
+{
+public:
+	static constexpr std::size_t kPerBlock = BlockBytes / sizeof(T) > 0 ? BlockBytes / sizeof(T) : 1;
+
+	using value_type = T;
+
+	template<typename Ref, typename Ptr>
+	class Iter
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = Ptr;
+		using reference = Ref;
+
+		Iter(const SegmentedVector *v_, std::size_t block_, T *cur_, T *last_) : v(v_), block(block_), cur(cur_), last(last_)
+		{
+
+		}
+
+		Ref operator*() const
+		{
+			return *cur;
+		}
+
+		Ptr operator->() const
+		{
+			return cur;
+		}
+
+		Iter& operator++()
+		{
+			++cur;
+			if (cur == last && block + 1 < v->blocks.size()) {
+				// һ
+				block++;
+				cur = v->blocks[block];
+				last = cur + v->usedIn(block);
+			}
+			return *this;
+		}
+
+		bool operator==(const Iter &rhs) const
+		{
+			return cur == rhs.cur;
+		}
+
+		bool operator!=(const Iter &rhs) const
+		{
+			return cur != rhs.cur;
+		}
+
+	private:
+		const SegmentedVector *v;
+		std::size_t block;
+		T *cur;
+		T *last;
+	};
+
+	using iterator = Iter<T&, T*>;
+	using const_iterator = Iter<const T&, const T*>;
+
+	SegmentedVector() : topEnd(nullptr), blockBegin(nullptr), blockEnd(nullptr)
+	{
+
+	}
+
+	SegmentedVector(const SegmentedVector &rhs) : topEnd(nullptr), blockBegin(nullptr), blockEnd(nullptr)
+	{
+		for (const auto &it : rhs) {
+			push_back(it);
+		}
+	}
+
+	SegmentedVector& operator=(const SegmentedVector &rhs)
+	{
+		if (this != &rhs) {
+			clear();
+			for (const auto &it : rhs) {
+				push_back(it);
+			}
+		}
+		return *this;
+	}
+
+	~SegmentedVector()
+	{
+		clear();
+		shrink_to_fit();
+	}
+
+	void push_back(const T &elem)
+	{
+		emplace_back(elem);
+	}
+
+	void push_back(T &&elem)
+	{
+		emplace_back(std::move(elem));
+	}
+
+	template<typename... Args>
+	T& emplace_back(Args&&... args)
+	{
+		if (topEnd == blockEnd) {
+			addBlock();
+		}
+
+		T *p = new (topEnd) T(std::forward<Args>(args)...);
+		topEnd++;
+		return *p;
+	}
+
+	// ѹ n Ԫأ鿽һڲ std::uninitialized_copyƽ; memmove
+	void push_n(const T *src, std::size_t n)
+	{
+		while (n > 0) {
+			if (topEnd == blockEnd) {
+				addBlock();
+			}
+
+			std::size_t room = static_cast<std::size_t>(blockEnd - topEnd);
+			std::size_t k = n < room ? n : room;
+			topEnd = std::uninitialized_copy(src, src + k, topEnd);
+			src += k;
+			n -= k;
+		}
+	}
+
+	void pop_back()
+	{
+		assert(!empty());
+
+		topEnd--;
+		topEnd->~T();
+
+		// һˣŽͷ
+		if (topEnd == blockBegin) {
+			spare.push_back(blockBegin);
+			blocks.pop_back();
+			blockBegin = blocks.empty() ? nullptr : blocks.back();
+			topEnd = blockEnd = blocks.empty() ? nullptr : blockBegin + kPerBlock;
+		}
+	}
+
+	T& back()
+	{
+		assert(!empty());
+		return topEnd[-1];
+	}
+
+	const T& back() const
+	{
+		assert(!empty());
+		return topEnd[-1];
+	}
+
+	T& operator[](std::size_t i)
+	{
+		return *slot(i);
+	}
+
+	bool empty() const
+	{
+		return topEnd == nullptr; // յĿŻؿֻҪпʹãջͲΪ
+	}
+
+	std::size_t size() const
+	{
+		return blocks.empty() ? 0 : (blocks.size() - 1) * kPerBlock + static_cast<std::size_t>(topEnd - blockBegin);
+	}
+
+	void clear()
+	{
+		while (!empty()) {
+			pop_back();
+		}
+	}
+
+	// ͷſеĿ
+	void shrink_to_fit()
+	{
+		for (auto p : spare) {
+			::operator delete(p);
+		}
+		spare.clear();
+	}
+
+	// ԿΪλf(ָڵһԪصָ, Ԫظ)ڶÿһ
+	template<typename F>
+	void for_each_block(F f) const
+	{
+		for (std::size_t b = 0; b < blocks.size(); b++) {
+			f(static_cast<const T*>(blocks[b]), usedIn(b));
+		}
+	}
+
+	iterator begin()
+	{
+		return blocks.empty() ? end() : iterator(this, 0, blocks[0], blocks[0] + usedIn(0));
+	}
+
+	iterator end()
+	{
+		return iterator(this, blocks.size(), topEnd, topEnd);
+	}
+
+	const_iterator begin() const
+	{
+		return blocks.empty() ? end() : const_iterator(this, 0, blocks[0], blocks[0] + usedIn(0));
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(this, blocks.size(), topEnd, topEnd);
+	}
+
+private:
+	T* slot(std::size_t i) const
+	{
+		return blocks[i / kPerBlock] + i % kPerBlock;
+	}
+
+	std::size_t usedIn(std::size_t b) const
+	{
+		return b + 1 < blocks.size() ? kPerBlock : static_cast<std::size_t>(topEnd - blockBegin);
+	}
+
+	void addBlock()
+	{
+		if (!spare.empty()) {
+			blocks.push_back(spare.back());
+			spare.pop_back();
+		}
+		else {
+			blocks.push_back(static_cast<T*>(::operator new(kPerBlock * sizeof(T))));
+		}
+
+		topEnd = blockBegin = blocks.back();
+		blockEnd = blockBegin + kPerBlock;
+	}
+
+private:
+	std::vector<T*> blocks; // ʹõĿ飬һûз
+	std::vector<T*> spare;  // ѾաȴõĿ
+	T *topEnd;     // ջԪصһλãpush/pop/back ֻҪָ
+	T *blockBegin; // һĿͷĩβ
+	T *blockEnd;
+};
+
+// 𵴵ѹջ/ջ base ȵĻϣѹ swing Ԫȫ
+template<typename S>
+void benchmark(const char *name, std::size_t base, std::size_t swing, int rounds)
+{
+	S s;
+	for (std::size_t i = 0; i < base; i++) {
+		s.push(static_cast<int>(i));
+	}
+
+	long long checksum = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++) {
+		for (std::size_t i = 0; i < swing; i++) {
+			s.push(static_cast<int>(i));
+		}
+		for (std::size_t i = 0; i < swing; i++) {
+			checksum += s.top();
+			s.pop();
+		}
+	}
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::cout << name << " : " << elapsed.count() << " ms (checksum " << checksum << ")" << std::endl;
+}
+
+int main()
+{
+	Stack<int, SegmentedVector<int, 16>> s; // ÿֻ 4  int۲
+	for (int i = 0; i < 10; i++) {
+		s.push(i);
+	}
+	s.printStack();
+
+	SegmentedVector<double> v;
+	double values[] = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+	v.push_n(values, 5);
+	double sum = 0;
+	v.for_each_block([&sum](const double *p, std::size_t n) {
+		for (std::size_t i = 0; i < n; i++) {
+			sum += p[i];
+		}
+	});
+	std::cout << "sum = " << sum << std::endl;
+
+	//  100 ԪصĻϣѹ/ 3000 ԪأԽɸı߽磩
+	const std::size_t base = 1000000;
+	const std::size_t swing = 3000;
+	const int rounds = 20000;
+	benchmark<Stack<int, std::vector<int>>>("std::vector             ", base, swing, rounds);
+	benchmark<Stack<int, std::deque<int>>>("std::deque              ", base, swing, rounds);
+	benchmark<Stack<int, SegmentedVector<int, 4096>>>("SegmentedVector<int, 4K>", base, swing, rounds);
+	benchmark<Stack<int, SegmentedVector<int>>>("SegmentedVector<int, 64K>", base, swing, rounds);
+
+	return 0;
+}
@@ -0,0 +1,437 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/* ģӦ--洢ڴӳļС´򿪼ɻָ MappedStack */
+
+// 6_ģ.cpp е Stack<T>ȥ˹캯еĴӡprintStack() һջıʽдļ
+template<typename T>
+class Stack
+{
+public:
+	void push(const T &elem)
+	{
+		s.push_back(elem);
+	}
+
+	void pop()
+	{
+		assert(!s.empty());
+
+		s.pop_back();
+	}
+
+	const T& top()
+	{
+		assert(!s.empty());
+
+		return s.back();
+	}
+
+	bool empty() const
+	{
+		return s.empty();
+	}
+
+	void printStack(std::ostream &os = std::cout) const
+	{
+		for (auto it : s) {
+			os << it << '\n';
+		}
+	}
+
+private:
+	std::vector<T> s;
+};
+
+// ӳļļ򿪣򴴽ȡ/޸ļСļӳ䵽ڴ桢޸дش
+class MappedFile
+{
+public:
+	explicit MappedFile(const char *path) : addr(nullptr), bytes(0)
+	{
+#ifdef _WIN32
+		mapping = nullptr;
+		file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			throw std::runtime_error(std::string("cannot open ") + path);
+		}
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size)) {
+			closeFile();
+			throw std::runtime_error(std::string("cannot get the size of ") + path);
+		}
+		bytes = static_cast<std::size_t>(size.QuadPart);
+#else
+		fd = open(path, O_RDWR | O_CREAT, 0644);
+		if (fd < 0) {
+			throw std::runtime_error(std::string("cannot open ") + path);
+		}
+
+		struct stat st;
+		if (fstat(fd, &st) != 0) {
+			closeFile();
+			throw std::runtime_error(std::string("cannot get the size of ") + path);
+		}
+		bytes = static_cast<std::size_t>(st.st_size);
+#endif
+		// 캯׳쳣ʱִУѾ򿪵ļҪر
+		if (bytes > 0) {
+			try {
+				map();
+			}
+			catch (...) {
+				closeFile();
+				throw;
+			}
+		}
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	~MappedFile()
+	{
+		unmap();
+		closeFile();
+	}
+
+	char* data() const
+	{
+		return addr;
+	}
+
+	std::size_t size() const
+	{
+		return bytes;
+	}
+
+	// ıļСӳ䣬֮ǰĵַʧЧ
+	void resize(std::size_t newBytes)
+	{
+		unmap();
+#ifdef _WIN32
+		LARGE_INTEGER size;
+		size.QuadPart = static_cast<LONGLONG>(newBytes);
+		if (!SetFilePointerEx(file, size, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+			throw std::runtime_error("cannot resize mapped file");
+		}
+#else
+		if (ftruncate(fd, static_cast<off_t>(newBytes)) != 0) {
+			throw std::runtime_error("cannot resize mapped file");
+		}
+#endif
+		bytes = newBytes;
+		map();
+	}
+
+	//  [offset, offset + n) б޸ĵҳдش̣ʱѾ
+	void flush(std::size_t offset, std::size_t n)
+	{
+#ifdef _WIN32
+		FlushViewOfFile(addr + offset, n);
+		FlushFileBuffers(file);
+#else
+		// msync Ҫʼַҳ
+		std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+		std::size_t begin = offset / page * page;
+		msync(addr + begin, offset + n - begin, MS_SYNC);
+#endif
+	}
+
+private:
+	void map()
+	{
+#ifdef _WIN32
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+		if (mapping == nullptr) {
+			throw std::runtime_error("cannot map file");
+		}
+		addr = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes));
+		if (addr == nullptr) {
+			CloseHandle(mapping);
+			mapping = nullptr;
+			throw std::runtime_error("cannot map file");
+		}
+#else
+		void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (p == MAP_FAILED) {
+			throw std::runtime_error("cannot map file");
+		}
+		addr = static_cast<char*>(p);
+#endif
+	}
+
+	void closeFile()
+	{
+#ifdef _WIN32
+		CloseHandle(file);
+#else
+		close(fd);
+#endif
+	}
+
+	void unmap()
+	{
+		if (addr == nullptr) {
+			return;
+		}
+#ifdef _WIN32
+		UnmapViewOfFile(addr);
+		CloseHandle(mapping);
+		mapping = nullptr;
+#else
+		munmap(addr, bytes);
+#endif
+		addr = nullptr;
+	}
+
+private:
+#ifdef _WIN32
+	HANDLE file;
+	HANDLE mapping;
+#else
+	int fd;
+#endif
+	char *addr;
+	std::size_t bytes;
+};
+
+// ļм¼ͱǩ´ʱȷļȷʵ T
+// Ĭ sizeofalignof ԼǷΪ//з϶ɣ
+// Сͬ岻ͬĽṹ壨ͬ 8 ֽ structػ TypeTag Եֵ
+template<typename T>
+struct TypeTag
+{
+	static constexpr std::uint64_t value = (static_cast<std::uint64_t>(sizeof(T)) << 32)
+		| (static_cast<std::uint64_t>(alignof(T)) << 16)
+		| (std::is_floating_point<T>::value ? 4u : 0u)
+		| (std::is_signed<T>::value ? 2u : 0u)
+		| (std::is_integral<T>::value ? 1u : 0u);
+};
+
+// MappedStackԪֱӴڴӳļļͷһ¼ count/capacity/ͱǩ ļͷ
+// ҪһֻܴſƽͣļеֽھԪرҪл
+// Ҫļ kGrowBytes һһÿҪӳ䣻
+// Ҫдشֻڵ sync() ʱʱϵͳҲҳдأ֤ʱ
+// Ҫģ´ͬһļʱֻҪӳ䲢ļͷO(1) ͻָջҪκı
+template<typename T>
+class MappedStack
+{
+	static_assert(std::is_trivially_copyable<T>::value, "MappedStack<T> requires a trivially copyable T");
+
+	struct Header
+	{
+		char magic[8];
+		std::uint64_t typeTag;
+		std::uint64_t elemSize;
+		std::uint64_t count;
+		std::uint64_t capacity;
+	};
+
+	static constexpr std::size_t kHeaderBytes = 64; // ļͷռ 64 ֽڣ֤Ԫض
+	static constexpr std::size_t kGrowBytes = std::size_t(4) << 20; // ÿ 4 MB
+	static_assert(sizeof(Header) <= kHeaderBytes && alignof(T) <= kHeaderBytes, "header too small");
+
+public:
+	explicit MappedStack(const char *path) : file(path)
+	{
+		if (file.size() == 0) {
+			// ļдļͷ
+			file.resize(kHeaderBytes + kGrowBytes);
+			Header *h = header();
+			std::memcpy(h->magic, "MSTACK1", 8);
+			h->typeTag = TypeTag<T>::value;
+			h->elemSize = sizeof(T);
+			h->count = 0;
+			h->capacity = kGrowBytes / sizeof(T);
+		}
+		else {
+			Header *h = header();
+			if (file.size() < kHeaderBytes || std::memcmp(h->magic, "MSTACK1", 8) != 0) {
+				throw std::runtime_error("not a MappedStack file");
+			}
+			if (h->typeTag != TypeTag<T>::value || h->elemSize != sizeof(T)) {
+				throw std::runtime_error("MappedStack file holds a different element type");
+			}
+		}
+	}
+
+	void push(const T &elem)
+	{
+		Header *h = header();
+		if (h->count == h->capacity) {
+			grow();
+			h = header();
+		}
+
+		elems()[h->count] = elem;
+		h->count++;
+	}
+
+	void pop()
+	{
+		assert(!empty());
+
+		header()->count--;
+	}
+
+	const T& top()
+	{
+		assert(!empty());
+
+		return elems()[header()->count - 1];
+	}
+
+	bool empty() const
+	{
+		return header()->count == 0;
+	}
+
+	std::size_t size() const
+	{
+		return static_cast<std::size_t>(header()->count);
+	}
+
+	// ļͷԪдش
+	void sync()
+	{
+		file.flush(0, kHeaderBytes + size() * sizeof(T));
+	}
+
+	void printStack() const
+	{
+		for (std::size_t i = 0; i < size(); i++) {
+			std::cout << elems()[i] << std::endl;
+		}
+	}
+
+private:
+	Header* header() const
+	{
+		return reinterpret_cast<Header*>(file.data());
+	}
+
+	T* elems() const
+	{
+		return reinterpret_cast<T*>(file.data() + kHeaderBytes);
+	}
+
+	void grow()
+	{
+		file.resize(file.size() + kGrowBytes);
+		header()->capacity = (file.size() - kHeaderBytes) / sizeof(T);
+	}
+
+private:
+	MappedFile file;
+};
+
+template<typename F>
+double measure(F f)
+{
+	auto start = std::chrono::steady_clock::now();
+	f();
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count();
+}
+
+int main()
+{
+	const char *ckpt = "mapped_stack.ckpt";
+	const char *text = "mapped_stack.txt";
+	std::remove(ckpt);
+	std::remove(text);
+
+	{
+		MappedStack<int> s(ckpt);
+		for (int i = 0; i < 5; i++) {
+			s.push(i * 10);
+		}
+		s.sync();
+	}
+	{
+		MappedStack<int> s(ckpt); // ´򿪣һε 5 Ԫض
+		s.printStack();
+
+		try {
+			MappedStack<double> wrong(ckpt);
+		}
+		catch (const std::exception &e) {
+			std::cout << "reopen as MappedStack<double> : " << e.what() << std::endl;
+		}
+	}
+	std::remove(ckpt);
+
+	// һǧ long long ļ㣺ıлд/ vs ӳļ sync()/´
+	const long long n = 10000000;
+	long long checksum = 0;
+
+	Stack<long long> memory;
+	for (long long i = 0; i < n; i++) {
+		memory.push(i * 2654435761ll);
+	}
+
+	double textSave = measure([&]() {
+		std::ofstream out(text);
+		memory.printStack(out);
+	});
+
+	double textLoad = measure([&]() {
+		Stack<long long> restored;
+		std::ifstream in(text);
+		long long v;
+		while (in >> v) {
+			restored.push(v);
+		}
+		checksum += restored.top();
+	});
+
+	{
+		MappedStack<long long> mapped(ckpt);
+		for (long long i = 0; i < n; i++) {
+			mapped.push(i * 2654435761ll);
+		}
+
+		double mappedSave = measure([&]() {
+			mapped.sync();
+		});
+
+		std::cout << "checkpoint  text : " << textSave << " ms, mapped sync() : " << mappedSave << " ms" << std::endl;
+	}
+
+	double mappedLoad = measure([&]() {
+		MappedStack<long long> restored(ckpt);
+		checksum += restored.top();
+	});
+
+	std::cout << "restore     text : " << textLoad << " ms, mapped reopen : " << mappedLoad << " ms" << std::endl;
+	std::cout << "checksum = " << checksum << std::endl;
+
+	std::remove(ckpt);
+	std::remove(text);
+
+	return 0;
+}